@@ -8,25 +8,84 @@
 // Maximum number of points awarded by this program is determined by the
 // constants POINTS[1], POINTS[2]...
 
+#include <algorithm>   // provides sort, lower_bound and equal.
+#include <cmath>       // provides signbit.
 #include <iostream>    // provides cout.
 #include <cstring>     // provides memcpy.
-#include <cstdlib>     // provides size_t.
+#include <cstdlib>     // provides size_t, malloc and free.
+#include <new>         // provides bad_alloc and nothrow_t.
+#include <sstream>     // provides istringstream and ostringstream.
+#include <string>      // provides string.
+#include <utility>     // provides move.
+#include <vector>      // provides vector.
 #include "Sequence.h"  // provides the sequence class with double items.
 using namespace std;
 using namespace CS3358_FA2021;
 
+// Every dynamic allocation this program makes goes through the
+// replacements of operator new below, which count them in allocations
+// (so test8 and test9 can tell when a sequence allocates).
+size_t allocations = 0;
+
+void* operator new(size_t bytes)
+{
+    ++allocations;
+    void* memory = malloc(bytes > 0 ? bytes : 1);
+    if (memory == 0)
+        throw bad_alloc();
+    return memory;
+}
+
+void* operator new[](size_t bytes)
+{
+    return operator new(bytes);
+}
+
+// (std::stable_sort gets its scratch memory from these)
+void* operator new(size_t bytes, const nothrow_t&) noexcept
+{
+    ++allocations;
+    return malloc(bytes > 0 ? bytes : 1);
+}
+
+void* operator new[](size_t bytes, const nothrow_t& tag) noexcept
+{
+    return operator new(bytes, tag);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
 // Descriptions and points for each of the tests:
-const size_t MANY_TESTS = 7;
+const size_t MANY_TESTS = 18;
 const int POINTS[MANY_TESTS+1] =
 {
-    21,  // Total points for all tests.
+    43,  // Total points for all tests.
      4,  // Test 1 points
      4,  // Test 2 points
      4,  // Test 3 points
      2,  // Test 4 points
      2,  // Test 5 points
      2,  // Test 6 points
-     3  // Test 7 points
+     3, // Test 7 points
+     2, // Test 8 points
+     2, // Test 9 points
+     2, // Test 10 points
+     2, // Test 11 points
+     2, // Test 12 points
+     2, // Test 13 points
+     2, // Test 14 points
+     2, // Test 15 points
+     2, // Test 16 points
+     2, // Test 17 points
+     2  // Test 18 points
 };
 const char DESCRIPTION[MANY_TESTS+1][256] =
 {
@@ -37,7 +96,18 @@ const char DESCRIPTION[MANY_TESTS+1][256] =
     "Testing the resize member function",
     "Testing the copy constructor",
     "Testing the assignment operator",
-    "Testing insert/attach when current DEFAULT_CAPACITY exceeded"
+    "Testing insert/attach when current DEFAULT_CAPACITY exceeded",
+    "Testing that moving a sequence allocates no memory",
+    "Testing reserve, shrink_to_fit and set_growth_factor",
+    "Testing insert_range and attach_range",
+    "Testing the numeric functions against plain loops",
+    "Testing the iterators across the free room in the array",
+    "Testing that copies share items until one is changed",
+    "Testing sort and stable_sort",
+    "Testing remove_if and erase_range",
+    "Testing cursors bound to a sequence",
+    "Testing write_binary and read_binary",
+    "Testing undo, redo and checkpoint"
 };
 
 
@@ -724,6 +794,1154 @@ int test7()
     return POINTS[7];
 }
 
+// **************************************************************************
+// sequence make_sequence(size_t n, size_t& allocations_when_built)
+//   Postcondition: A sequence holding 1, 2, ..., n (with the cursor at n)
+//   has been returned by value, and allocations_when_built has been set to
+//   the count of allocations made once the sequence was complete (so the
+//   caller can tell whether returning it allocated).
+// **************************************************************************
+sequence make_sequence(size_t n, size_t& allocations_when_built)
+{
+    sequence result;
+    size_t i;
+
+    for (i = 1; i <= n; i++)
+        result.attach(i);
+    allocations_when_built = allocations;
+    return result;
+}
+
+// **************************************************************************
+// int test8()
+//   Checks that returning a sequence by value, move construction and move
+//   assignment take over the items without allocating any memory.
+//   Returns POINTS[8] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test8()
+{
+    double items[2*sequence::DEFAULT_CAPACITY];
+    size_t i;
+    size_t before;  // allocations before the operation being tested
+
+    // Set up the items array to contain 1...2*DEFAULT_CAPACITY.
+    for (i = 1; i <= 2*sequence::DEFAULT_CAPACITY; i++)
+        items[i-1] = i;
+
+    cout << "Returning a sequence of " << 2*sequence::DEFAULT_CAPACITY;
+    cout << " items by value from a function." << endl;
+    sequence returned(make_sequence(2*sequence::DEFAULT_CAPACITY, before));
+    if (allocations != before)
+    {
+        cout << "    Returning the sequence allocated memory." << endl;
+        return 0;
+    }
+    if (!correct
+        (returned, 2*sequence::DEFAULT_CAPACITY,
+         2*sequence::DEFAULT_CAPACITY-1, items)
+        )
+        return 0;
+
+    cout << "Move constructing a sequence from it." << endl;
+    before = allocations;
+    sequence moved(std::move(returned));
+    if (allocations != before)
+    {
+        cout << "    The move constructor allocated memory." << endl;
+        return 0;
+    }
+    // (correct moved the cursor off the sequence it checked)
+    if (!correct
+        (moved, 2*sequence::DEFAULT_CAPACITY,
+         2*sequence::DEFAULT_CAPACITY, items)
+        )
+        return 0;
+    if (!test_basic(returned, 0, false))
+        return 0;
+
+    cout << "Move assigning it to a sequence that has items of its own."
+         << endl;
+    sequence target;
+    target.attach(-1);
+    target.attach(-2);
+    before = allocations;
+    target = std::move(moved);
+    if (allocations != before)
+    {
+        cout << "    The move assignment allocated memory." << endl;
+        return 0;
+    }
+    // (correct left moved's cursor at its first item)
+    if (!correct(target, 2*sequence::DEFAULT_CAPACITY, 0, items))
+        return 0;
+    if (!test_basic(moved, 0, false))
+        return 0;
+
+    // All tests passed
+    cout << "All tests of this eighth function have been passed." << endl;
+    return POINTS[8];
+}
+
+// **************************************************************************
+// int test9()
+//   Checks that reserve, shrink_to_fit and set_growth_factor allocate
+//   memory when (and only when) the documentation says they should, that
+//   none of them changes the items or the cursor, and that a sequence
+//   that has been moved from can be used again.
+//   Returns POINTS[9] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test9()
+{
+    double items[201];
+    size_t i;
+    size_t before;  // allocations before the operation being tested
+
+    // Set up the items array to contain 1...201.
+    for (i = 1; i <= 201; i++)
+        items[i-1] = i;
+
+    cout << "Reserving room for 100 items, then attaching 100 items." << endl;
+    sequence test;
+    test.reserve(100);
+    before = allocations;
+    for (i = 1; i <= 100; i++)
+        test.attach(i);
+    if (allocations != before)
+    {
+        cout << "    Attaching within the reserved capacity allocated memory."
+             << endl;
+        return 0;
+    }
+    if (!correct(test, 100, 99, items))
+        return 0;
+
+    cout << "Reserving less than the capacity (nothing should happen)."
+         << endl;
+    test.start();
+    test.advance();
+    before = allocations;
+    test.reserve(10);
+    if (allocations != before)
+    {
+        cout << "    A reserve that was too small allocated memory." << endl;
+        return 0;
+    }
+    if (!correct(test, 100, 1, items))
+        return 0;
+
+    cout << "Calling shrink_to_fit with the cursor on item [50]." << endl;
+    test.start();
+    for (i = 0; i < 50; i++)
+        test.advance();
+    test.shrink_to_fit();
+    if (!correct(test, 100, 50, items))
+        return 0;
+    cout << "Attaching one more item (the capacity should now be full)."
+         << endl;
+    test.set_growth_factor(2.0);
+    before = allocations;
+    test.attach(101);
+    if (allocations == before)
+    {
+        cout << "    After shrink_to_fit the sequence still had room." << endl;
+        return 0;
+    }
+    cout << "With a growth factor of 2, the capacity should have grown to\n";
+    cout << "2 * 100 + 1, so 100 more attaches should not allocate." << endl;
+    before = allocations;
+    for (i = 102; i <= 201; i++)
+        test.attach(i);
+    if (allocations != before)
+    {
+        cout << "    The capacity did not grow by the growth factor." << endl;
+        return 0;
+    }
+    if (!correct(test, 201, 200, items))
+        return 0;
+
+    cout << "Moving the sequence away and using the moved-from sequence."
+         << endl;
+    sequence moved(std::move(test));
+    if (!test_basic(test, 0, false))
+        return 0;
+    test.attach(1);
+    test.attach(2);
+    test.reserve(5);
+    test.attach(3);
+    if (!correct(test, 3, 2, items))
+        return 0;
+    if (!correct(moved, 201, 201, items))
+        return 0;
+
+    // All tests passed
+    cout << "All tests of this ninth function have been passed." << endl;
+    return POINTS[9];
+}
+
+// **************************************************************************
+// int test10()
+//   Checks where insert_range and attach_range put the items and the
+//   cursor (with and without a current item, and for an empty range), and
+//   that a range longer than the free room grows the capacity only once.
+//   Returns POINTS[10] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test10()
+{
+    double first[3] = { 1, 2, 3 };
+    double middle[2] = { 10, 11 };
+    double after[3] = { 20, 21, 22 };
+    double front[2] = { -1, -2 };
+    double end[1] = { 30 };
+    double items1[3] = { 1, 2, 3 };
+    double items2[5] = { 1, 10, 11, 2, 3 };
+    double items3[8] = { 1, 10, 11, 20, 21, 22, 2, 3 };
+    double items4[10] = { -1, -2, 1, 10, 11, 20, 21, 22, 2, 3 };
+    double items5[11] = { -1, -2, 1, 10, 11, 20, 21, 22, 2, 3, 30 };
+    double many[100];
+    double items6[103];
+    size_t i;
+    size_t before;  // allocations before the operation being tested
+
+    cout << "Attaching the range 1, 2, 3 to an empty sequence." << endl;
+    sequence test;
+    test.attach_range(first, first + 3);
+    if (!correct(test, 3, 2, items1))
+        return 0;
+
+    cout << "Inserting the range 10, 11 before the item 2." << endl;
+    test.start();
+    test.advance();
+    test.insert_range(middle, middle + 2);
+    if (!correct(test, 5, 2, items2))
+        return 0;
+
+    cout << "Attaching the range 20, 21, 22 after the item 11." << endl;
+    test.start();
+    test.advance();
+    test.advance();
+    test.attach_range(after, after + 3);
+    if (!correct(test, 8, 5, items3))
+        return 0;
+
+    cout << "Inserting and attaching empty ranges (nothing should change)."
+         << endl;
+    for (i = 0; i < 5; i++)
+        test.advance();
+    test.insert_range(front, front);
+    test.attach_range(end, end);
+    if (!correct(test, 8, 8, items3))
+        return 0;
+
+    cout << "Inserting the range -1, -2 with no current item." << endl;
+    test.insert_range(front, front + 2);
+    if (!correct(test, 10, 1, items4))
+        return 0;
+
+    cout << "Attaching the range 30 with no current item." << endl;
+    test.attach_range(end, end + 1);
+    if (!correct(test, 11, 10, items5))
+        return 0;
+
+    cout << "Inserting 100 items into the middle of a 3-item sequence of\n";
+    cout << "capacity 5 (the capacity should grow only once)." << endl;
+    for (i = 0; i < 100; i++)
+        many[i] = 100 + i;
+    items6[0] = 1;
+    for (i = 0; i < 100; i++)
+        items6[i+1] = many[i];
+    items6[101] = 2;
+    items6[102] = 3;
+    sequence small(5);
+    small.attach_range(first, first + 3);
+    small.start();
+    small.advance();
+    before = allocations;
+    small.insert_range(many, many + 100);
+    // growing once takes one array (and the count it shares it with)
+    if (allocations - before > 2)
+    {
+        cout << "    The capacity was grown more than once." << endl;
+        return 0;
+    }
+    if (!correct(small, 103, 100, items6))
+        return 0;
+
+    // All tests passed
+    cout << "All tests of this tenth function have been passed." << endl;
+    return POINTS[10];
+}
+
+// **************************************************************************
+// sequence with_split_at(const double values[], size_t n, size_t split)
+//   Precondition: split < n.
+//   Postcondition: A sequence holding values[0] ... values[n-1] has been
+//   returned. If split < n - 1, it was built by attaching all the items
+//   but values[split] and then inserting that one in its place, so that
+//   (since a cursor insert leaves the free room of the array right after
+//   the inserted item) the items are stored in two runs, split after item
+//   [split], with the second one starting at an odd place in the array.
+//   Otherwise the items were just attached.
+// **************************************************************************
+sequence with_split_at(const double values[], size_t n, size_t split)
+{
+    sequence result;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if (i != split || split == n - 1)
+            result.attach(values[i]);
+    if (split < n - 1)
+    {
+        result.start();
+        for (i = 0; i < split; i++)
+            result.advance();
+        result.insert(values[split]);
+    }
+    return result;
+}
+
+// **************************************************************************
+// bool close_to(double value, double expected)
+//   Postcondition: The return value is true if value is within a relative
+//   error of 1e-12 of expected (for results whose rounding depends on the
+//   order in which the items are added up).
+// **************************************************************************
+bool close_to(double value, double expected)
+{
+    double error = value > expected ? value - expected : expected - value;
+    double scale = expected < 0 ? -expected : expected;
+    return error <= 1e-12 * (scale > 1 ? scale : 1);
+}
+
+// **************************************************************************
+// int test11()
+//   Checks sum, mean, min, max, variance, dot, scale and offset against
+//   plain front-to-back loops, for every length from 1 to 40 items (so
+//   both the vectorized part and the leftover items are exercised) and for
+//   items stored in one run or split in two at the front, middle and back.
+//   The items are multiples of 1/4 small enough that every sum is exact.
+//   Returns POINTS[11] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test11()
+{
+    const size_t MOST = 40;
+    double values[MOST];
+    double reversed[MOST];
+    size_t n, s, i;
+
+    cout << "Comparing the numeric functions with plain loops over the\n";
+    cout << "items for 1 to " << MOST << " items, stored in one or two runs...";
+    cout << endl;
+    for (n = 1; n <= MOST; n++)
+    {
+        for (i = 0; i < n; i++)
+            values[i] = int((i * 7919 + n * 31) % 23) - 11 + 0.25 * (i % 4);
+        for (i = 0; i < n; i++)
+            reversed[i] = values[n - 1 - i];
+
+        double sum = 0, low = values[0], high = values[0], dot = 0;
+        for (i = 0; i < n; i++)
+        {
+            sum += values[i];
+            dot += values[i] * reversed[i];
+            if (values[i] < low)
+                low = values[i];
+            if (values[i] > high)
+                high = values[i];
+        }
+        double mean = sum / n;
+        double variance = 0;
+        for (i = 0; i < n; i++)
+            variance += (values[i] - mean) * (values[i] - mean);
+        variance /= n;
+
+        size_t splits[4] = { 0, 1, n / 2, n - 2 };
+        for (s = 0; s < 4; s++)
+        {
+            if (splits[s] >= n)
+                continue;
+            sequence test = with_split_at(values, n, splits[s]);
+            sequence other = with_split_at(reversed, n, n / 3);
+            if (test.sum() != sum || test.sum(true) != sum
+                || test.mean() != mean || test.min() != low
+                || test.max() != high || !close_to(test.variance(), variance)
+                || test.dot(other) != dot || other.dot(test) != dot)
+            {
+                cout << "\n    A result was wrong for " << n << " items split"
+                     << " after item [" << splits[s] << "]." << endl;
+                return 0;
+            }
+
+            test.scale(3);
+            test.offset(0.5);
+            test.start();
+            for (i = 0; i < n && test.is_item(); i++, test.advance())
+                if (test.current() != values[i] * 3 + 0.5)
+                    break;
+            if (i != n || test.is_item())
+            {
+                cout << "\n    scale or offset was wrong for " << n
+                     << " items split after item [" << splits[s] << "]."
+                     << endl;
+                return 0;
+            }
+        }
+    }
+    cout << "Passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this eleventh function have been passed." << endl;
+    return POINTS[11];
+}
+
+// **************************************************************************
+// int test12()
+//   Checks the iterators of a sequence whose items are stored in two runs
+//   (see with_split_at): dereferencing, indexing, ++, --, += and -= across
+//   the split, differences and comparisons, conversion to const_iterator,
+//   writing through an iterator, and the standard algorithms sort and
+//   lower_bound. The cursor must not be moved by any of these.
+//   Returns POINTS[12] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test12()
+{
+    const size_t MANY = 20;
+    double values[MANY];
+    double sorted[MANY];
+    size_t i;
+
+    for (i = 0; i < MANY; i++)
+        values[i] = double((i * 7) % MANY);
+    for (i = 0; i < MANY; i++)
+        sorted[i] = i;
+
+    cout << "Testing begin() == end() for an empty sequence ... ";
+    sequence empty;
+    if (empty.begin() != empty.end())
+    {
+        cout << "Failed." << endl;
+        return 0;
+    }
+    cout << "Passed." << endl;
+
+    cout << "Walking the iterators of " << MANY << " items split after item\n";
+    cout << "[7] forward and backward, by 1 and by larger steps ... ";
+    sequence test = with_split_at(values, MANY, 7);
+    test.start();
+    test.advance();
+    test.advance();
+    sequence::iterator first = test.begin();
+    sequence::iterator last = test.end();
+    if (last - first != long(MANY) || first - last != -long(MANY))
+    {
+        cout << "Failed." << endl << "    end() - begin() is wrong." << endl;
+        return 0;
+    }
+    sequence::iterator it = first;
+    for (i = 0; i < MANY; i++, ++it)
+        if (*it != values[i] || first[i] != values[i]
+            || *(first + i) != values[i] || *(last - (MANY - i)) != values[i]
+            || it - first != long(i) || !(it < last) || !(first <= it))
+            break;
+    if (i != MANY || it != last)
+    {
+        cout << "Failed." << endl << "    Going forward, item [" << i
+             << "] was wrong." << endl;
+        return 0;
+    }
+    for (i = MANY; i > 0; i--)
+        if (*--it != values[i - 1])
+            break;
+    if (i != 0 || it != first)
+    {
+        cout << "Failed." << endl << "    Going backward, item [" << i - 1
+             << "] was wrong." << endl;
+        return 0;
+    }
+    it += 5;      // before the split
+    it += 6;      // across it
+    it -= 4;      // back across it
+    sequence::const_iterator constant = it;
+    if (*it != values[7] || *constant != values[7] || constant[5] != values[12]
+        || !(constant > sequence::const_iterator(first)))
+    {
+        cout << "Failed." << endl << "    += or -= across the split was wrong."
+             << endl;
+        return 0;
+    }
+    cout << "Passed." << endl;
+
+    cout << "Writing through an iterator, then sorting with std::sort and\n";
+    cout << "searching with std::lower_bound ... ";
+    *(first + 10) = values[10];    // (the same value, to keep the set)
+    std::sort(test.begin(), test.end());
+    sequence::iterator found =
+        std::lower_bound(test.begin(), test.end(), 13.0);
+    if (found - test.begin() != 13 || *found != 13.0)
+    {
+        cout << "Failed." << endl;
+        return 0;
+    }
+    cout << "Passed." << endl;
+    if (!correct(test, MANY, 2, sorted))
+        return 0;
+
+    // All tests passed
+    cout << "All tests of this twelfth function have been passed." << endl;
+    return POINTS[12];
+}
+
+// **************************************************************************
+// int test13()
+//   Checks the copy-on-write sharing of items between copies: copying and
+//   assigning allocate nothing, a write to either copy (by insert, attach,
+//   remove_current or through an iterator) never shows up in the other,
+//   and moving the cursor of one copy doesn't move the other's. Also
+//   checks the documented cost of the non-const begin: once it has been
+//   called, copies are made right away, until the capacity changes.
+//   Returns POINTS[13] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test13()
+{
+    double items1[5] = { 1, 2, 3, 4, 5 };
+    double items2[6] = { 1, 2, 3, 4, 5, 6 };
+    double items3[4] = { 1, 2, 4, 5 };
+    double items4[5] = { 100, 2, 3, 4, 5 };
+    size_t i;
+    size_t before;  // allocations before the operation being tested
+
+    sequence original;
+    for (i = 1; i <= 5; i++)
+        original.attach(i);
+
+    cout << "Copying a 5-item sequence and attaching 6 to the copy." << endl;
+    before = allocations;
+    sequence copy(original);
+    copy.start();
+    copy.advance();
+    if (allocations != before)
+    {
+        cout << "    Copying or moving the copy's cursor allocated memory."
+             << endl;
+        return 0;
+    }
+    for (i = 0; i < 4; i++)
+        copy.advance();
+    copy.attach(6);
+    if (!correct(copy, 6, 5, items2))
+        return 0;
+    if (!correct(original, 5, 4, items1))
+        return 0;
+
+    cout << "Assigning the original to a sequence and removing item [2]\n";
+    cout << "from the original." << endl;
+    sequence assigned;
+    before = allocations;
+    assigned = original;
+    if (allocations != before)
+    {
+        cout << "    The assignment allocated memory." << endl;
+        return 0;
+    }
+    original.start();
+    original.advance();
+    original.advance();
+    original.remove_current();
+    if (!correct(original, 4, 2, items3))
+        return 0;
+    if (!correct(assigned, 5, 5, items1))
+        return 0;
+
+    cout << "Copying a sequence, then writing through its begin()." << endl;
+    sequence shared(assigned);
+    *shared.begin() = 100;
+    // (correct left assigned's cursor at its first item)
+    if (!correct(shared, 5, 0, items4))
+        return 0;
+    if (!correct(assigned, 5, 0, items1))
+        return 0;
+
+    cout << "Copying it again while its iterator is still around (the copy\n";
+    cout << "should be made right away), then writing through the iterator."
+         << endl;
+    sequence::iterator written = shared.begin();
+    before = allocations;
+    sequence late(shared);
+    if (allocations == before)
+    {
+        cout << "    The copy shared the items iterators can write to." << endl;
+        return 0;
+    }
+    *written = 1;
+    if (!correct(late, 5, 5, items4))
+        return 0;
+    if (!correct(shared, 5, 5, items1))
+        return 0;
+
+    cout << "Growing its capacity (copies should share the items again)."
+         << endl;
+    shared.reserve(40);
+    before = allocations;
+    sequence cheap(shared);
+    if (allocations != before)
+    {
+        cout << "    The copy allocated memory." << endl;
+        return 0;
+    }
+    if (!correct(cheap, 5, 0, items1))
+        return 0;
+
+    // All tests passed
+    cout << "All tests of this thirteenth function have been passed." << endl;
+    return POINTS[13];
+}
+
+// **************************************************************************
+// bool sorted_stably(const sequence& test, const vector<double>& values,
+//                    bool stable)
+//   Postcondition: The return value is true if test holds the items of
+//   values in ascending order and, if stable is true, its zeros have the
+//   signs they had in values, in the same order (0.0 and -0.0 compare
+//   equal, so only a stable sort must keep them in order).
+// **************************************************************************
+bool sorted_stably(const sequence& test, const vector<double>& values,
+                   bool stable)
+{
+    vector<double> expected(values);
+    vector<bool> zero_signs;
+    size_t i;
+
+    std::sort(expected.begin(), expected.end());
+    for (i = 0; i < values.size(); i++)
+        if (values[i] == 0)
+            zero_signs.push_back(std::signbit(values[i]));
+    if (test.size() != values.size()
+        || !std::equal(test.begin(), test.end(), expected.begin()))
+        return false;
+    if (!stable)
+        return true;
+    size_t zeros = 0;
+    for (sequence::const_iterator it = test.begin(); it != test.end(); ++it)
+        if (*it == 0 && std::signbit(*it) != zero_signs[zeros++])
+            return false;
+    return true;
+}
+
+// **************************************************************************
+// int test14()
+//   Checks sort and stable_sort on a small sequence (sorted by the calling
+//   thread) and on one big enough to be sorted by several threads: the
+//   items must end up in ascending order, stable_sort must keep 0.0 and
+//   -0.0 in their original order, and the cursor must stay at the same
+//   position.
+//   Returns POINTS[14] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test14()
+{
+    const size_t SIZES[2] = { 100, 300000 };
+    size_t i, s;
+
+    for (s = 0; s < 2; s++)
+    {
+        size_t n = SIZES[s];
+        vector<double> values(n);
+        unsigned long state = 12345;
+        for (i = 0; i < n; i++)
+        {
+            state = (state * 1103515245 + 12345) % 2147483648UL;
+            // about a third zeros, of both signs, among small integers
+            long v = long(state >> 8) % 60 - 30;
+            values[i] = v % 3 == 0 ? (v < 0 ? -0.0 : 0.0) : double(v);
+        }
+
+        for (int stable = 0; stable <= 1; stable++)
+        {
+            cout << "Testing " << (stable ? "stable_sort" : "sort")
+                 << " with 4 threads on " << n << " items ... ";
+            sequence test;
+            test.attach_range(values.begin(), values.end());
+            test.start();
+            for (i = 0; i < n / 3; i++)
+                test.advance();
+            if (stable)
+                test.stable_sort(4);
+            else
+                test.sort(4);
+            if (!sorted_stably(test, values, stable != 0))
+            {
+                cout << "Failed." << endl;
+                return 0;
+            }
+            size_t position = 0;
+            while (test.is_item())
+            {
+                test.advance();
+                position++;
+            }
+            if (position != n - n / 3)
+            {
+                cout << "Failed." << endl << "    The cursor moved." << endl;
+                return 0;
+            }
+            cout << "Passed." << endl;
+        }
+    }
+
+    // All tests passed
+    cout << "All tests of this fourteenth function have been passed." << endl;
+    return POINTS[14];
+}
+
+// **************************************************************************
+// bool is_even(const double& item)
+//   Postcondition: The return value is true if item is an even number.
+// **************************************************************************
+bool is_even(const double& item)
+{
+    return long(item) % 2 == 0;
+}
+
+// **************************************************************************
+// int test15()
+//   Checks which items remove_if and erase_range remove, the count that
+//   remove_if returns, that remove_if calls its predicate once per item
+//   front to back, and where the cursor ends up: on the same item if it
+//   was kept, on the next remaining item if it was removed, and nowhere if
+//   there was none after it (or no cursor to begin with).
+//   Returns POINTS[15] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test15()
+{
+    double items1[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    double items2[5] = { 1, 3, 5, 7, 9 };
+    double items3[3] = { 5, 7, 9 };
+    double items4[2] = { 5, 7 };
+    double items5[6] = { 1, 2, 7, 8, 9, 10 };
+    double items6[5] = { 2, 7, 8, 9, 10 };
+    double items7[2] = { 2, 7 };
+    size_t i;
+
+    cout << "Removing the even items of 1...10 with the cursor on 4." << endl;
+    sequence test;
+    test.attach_range(items1, items1 + 10);
+    test.start();
+    for (i = 0; i < 3; i++)
+        test.advance();
+    vector<double> seen;
+    size_t removed = test.remove_if([&seen](const double& item)
+                                    {
+                                        seen.push_back(item);
+                                        return is_even(item);
+                                    });
+    if (removed != 5 || seen.size() != 10
+        || !std::equal(seen.begin(), seen.end(), items1))
+    {
+        cout << "    remove_if returned " << removed << " (should be 5) or"
+             << " did not call the predicate once per item in order." << endl;
+        return 0;
+    }
+    if (!correct(test, 5, 2, items2))
+        return 0;
+
+    cout << "Removing items below 4 with the cursor on 7." << endl;
+    test.start();
+    test.advance();
+    test.advance();
+    test.advance();
+    if (test.remove_if([](const double& item) { return item < 4; }) != 2)
+    {
+        cout << "    remove_if should have returned 2." << endl;
+        return 0;
+    }
+    if (!correct(test, 3, 1, items3))
+        return 0;
+
+    cout << "Removing nothing with no current item." << endl;
+    test.remove_if(is_even);
+    if (!correct(test, 3, 3, items3))
+        return 0;
+
+    cout << "Removing 9 with the cursor on it (the last item)." << endl;
+    test.start();
+    test.advance();
+    test.advance();
+    test.remove_if([](const double& item) { return item == 9; });
+    if (!correct(test, 2, 2, items4))
+        return 0;
+
+    cout << "Erasing items [2] through [5] of 1...10 with the cursor on\n";
+    cout << "item [4]." << endl;
+    sequence erased;
+    erased.attach_range(items1, items1 + 10);
+    erased.start();
+    for (i = 0; i < 4; i++)
+        erased.advance();
+    erased.erase_range(2, 6);
+    if (!correct(erased, 6, 2, items5))
+        return 0;
+
+    cout << "Erasing item [0] with the cursor on item [3], then an empty\n";
+    cout << "range." << endl;
+    erased.start();
+    for (i = 0; i < 3; i++)
+        erased.advance();
+    erased.erase_range(0, 1);
+    erased.erase_range(4, 4);
+    if (!correct(erased, 5, 2, items6))
+        return 0;
+
+    cout << "Erasing the last 3 items with the cursor on item [3], then\n";
+    cout << "the first item with no current item." << endl;
+    erased.start();
+    for (i = 0; i < 3; i++)
+        erased.advance();
+    erased.erase_range(2, 5);
+    if (!correct(erased, 2, 2, items7))
+        return 0;
+    // (correct left the cursor at the first item)
+    erased.advance();
+    erased.advance();
+    erased.erase_range(0, 1);
+    if (!correct(erased, 1, 1, items7 + 1))
+        return 0;
+
+    // All tests passed
+    cout << "All tests of this fifteenth function have been passed." << endl;
+    return POINTS[15];
+}
+
+// **************************************************************************
+// bool cursor_on(const sequence::cursor& c, const char name[], bool has_item,
+//                double item)
+//   Postcondition: The return value is true if c.is_item() is has_item and
+//   (if has_item is true) c.current() is item. A description of the test
+//   result is printed to cout.
+// **************************************************************************
+bool cursor_on(const sequence::cursor& c, const char name[], bool has_item,
+               double item)
+{
+    cout << "Testing that cursor " << name;
+    if (has_item)
+        cout << " is on " << item << " ... ";
+    else
+        cout << " has no current item ... ";
+    bool answer = c.is_item() == has_item && (!has_item || c.current() == item);
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    return answer;
+}
+
+// **************************************************************************
+// int test16()
+//   Checks that edits made through the sequence or any of its cursors
+//   keep every other current item on the same item (or move it to the
+//   next item if its own was removed), and what happens to cursors when
+//   their sequence is copied, sorted, assigned to or destroyed.
+//   Returns POINTS[16] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test16()
+{
+    double items1[6] = { 1, 2, 10, 3, 4, 5 };
+    double items2[3] = { 1, 2, 3 };
+    double items3[6] = { 0, 1, 2, 10, 3, 5 };
+    size_t i;
+
+    cout << "Binding cursors a (on 1) and b (on 4) to the sequence 1...5,\n";
+    cout << "then inserting 10 before 3 through the sequence." << endl;
+    sequence test;
+    for (i = 1; i <= 5; i++)
+        test.attach(i);
+    sequence::cursor a(test);
+    sequence::cursor b(test);
+    for (i = 0; i < 3; i++)
+        b.advance();
+    test.start();
+    test.advance();
+    test.advance();
+    test.insert(10);
+    if (!cursor_on(a, "a", true, 1) || !cursor_on(b, "b", true, 4)
+        || test.current() != 10)
+        return 0;
+
+    cout << "Removing 4 through b, then inserting 0 through a." << endl;
+    b.remove_current();
+    a.insert(0);
+    if (!cursor_on(a, "a", true, 0) || !cursor_on(b, "b", true, 5)
+        || test.current() != 10)
+        return 0;
+
+    cout << "Copying the sequence and emptying the copy (a copy has no\n";
+    cout << "cursors bound to it)." << endl;
+    sequence copy(test);
+    copy.erase_range(0, 6);
+    if (!cursor_on(a, "a", true, 0) || !cursor_on(b, "b", true, 5))
+        return 0;
+    if (!correct(test, 6, 3, items3))
+        return 0;
+
+    cout << "Removing 5 (the last item) through b, then erasing 10 and the\n";
+    cout << "first two items (a's 0 and 1) and attaching 1 through the\n";
+    cout << "sequence." << endl;
+    b.remove_current();
+    test.erase_range(3, 4);
+    test.erase_range(0, 2);
+    test.attach(1);
+    if (!cursor_on(a, "a", true, 2) || !cursor_on(b, "b", false, 0))
+        return 0;
+
+    cout << "Copying cursor a into c and advancing c, then sorting the\n";
+    cout << "sequence 2, 3, 1 (the cursors should keep their positions)."
+         << endl;
+    sequence::cursor c(a);
+    c.advance();
+    if (!cursor_on(c, "c", true, 3))
+        return 0;
+    test.sort();
+    if (!cursor_on(a, "a", true, 1) || !cursor_on(c, "c", true, 2))
+        return 0;
+    if (!correct(test, 3, 2, items2))
+        return 0;
+
+    cout << "Assigning a 6-item sequence to the sequence, then destroying\n";
+    cout << "a sequence that has a cursor bound to it." << endl;
+    copy.attach_range(items1, items1 + 6);
+    test = copy;
+    if (!cursor_on(a, "a", false, 0) || !cursor_on(c, "c", false, 0)
+        || !a.is_bound())
+        return 0;
+    sequence::cursor d;
+    {
+        sequence scoped;
+        scoped.attach_range(items1, items1 + 6);
+        sequence::cursor bound(scoped);
+        d = bound;
+        if (!cursor_on(d, "d", true, 1))
+            return 0;
+    }
+    if (d.is_bound() || !cursor_on(d, "d", false, 0))
+    {
+        cout << "    The cursor is still bound." << endl;
+        return 0;
+    }
+
+    // All tests passed
+    cout << "All tests of this sixteenth function have been passed." << endl;
+    return POINTS[16];
+}
+
+// **************************************************************************
+// bool holds(const sequence& test, size_t n, const double items[])
+//   Postcondition: The return value is true if test has exactly the n
+//   items items[0] ... items[n-1] and no current item.
+// **************************************************************************
+bool holds(const sequence& test, size_t n, const double items[])
+{
+    return test.size() == n && !test.is_item()
+        && std::equal(test.begin(), test.end(), items);
+}
+
+// **************************************************************************
+// int test17()
+//   Checks that write_binary and read_binary round-trip the items exactly
+//   (with and without the header, and two sequences written one after the
+//   other), that the header holds the magic and the item count, and that
+//   read_binary rejects a damaged item (CRC mismatch), a damaged magic and
+//   a truncated stream, leaving the sequence it reads into unchanged.
+//   Returns POINTS[17] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test17()
+{
+    const size_t MANY = 1000;
+    double values[MANY];
+    double others[3] = { -1, -2, -3 };
+    size_t i;
+
+    for (i = 0; i < MANY; i++)
+        values[i] = i * 0.1 - 7;
+
+    cout << "Writing " << MANY << " items (stored in two runs) and 3 items";
+    cout << " to a stream,\nthen reading them back ... ";
+    sequence written = with_split_at(values, MANY, 400);
+    sequence small;
+    small.attach_range(others, others + 3);
+    ostringstream out;
+    if (!written.write_binary(out) || !small.write_binary(out))
+    {
+        cout << "Failed." << endl << "    write_binary returned false." << endl;
+        return 0;
+    }
+    string bytes = out.str();
+    if (bytes.size() != 2 * 24 + (MANY + 3) * 8
+        || bytes.compare(0, 4, "SQB1") != 0
+        || (unsigned char)bytes[8] != MANY % 256
+        || (unsigned char)bytes[9] != MANY / 256)
+    {
+        cout << "Failed." << endl << "    The header or size was wrong."
+             << endl;
+        return 0;
+    }
+    istringstream in(bytes);
+    sequence first, second;
+    second.attach(5);
+    if (!first.read_binary(in) || !second.read_binary(in)
+        || !holds(first, MANY, values) || !holds(second, 3, others))
+    {
+        cout << "Failed." << endl;
+        return 0;
+    }
+    cout << "Passed." << endl;
+
+    cout << "Writing and reading the items without a header ... ";
+    ostringstream raw_out;
+    written.write_binary(raw_out, false);
+    istringstream raw_in(raw_out.str());
+    sequence raw;
+    if (raw_out.str().size() != MANY * 8 || !raw.read_binary(raw_in, false)
+        || !holds(raw, MANY, values))
+    {
+        cout << "Failed." << endl;
+        return 0;
+    }
+    cout << "Passed." << endl;
+
+    cout << "Reading a stream with one bit of an item flipped, with the\n";
+    cout << "magic damaged, and cut short (all should be rejected) ... ";
+    string damaged[3] = { bytes, bytes, bytes.substr(0, 24 + MANY * 8 - 1) };
+    damaged[0][24 + 8 * 500 + 3] ^= 0x10;
+    damaged[1][2] = 'X';
+    for (i = 0; i < 3; i++)
+    {
+        istringstream bad(damaged[i]);
+        sequence kept;
+        kept.attach_range(others, others + 3);
+        kept.start();
+        if (kept.read_binary(bad) || kept.size() != 3 || !kept.is_item()
+            || kept.current() != others[0]
+            || !std::equal(kept.begin(), kept.end(), others))
+        {
+            cout << "Failed." << endl << "    Damaged stream " << i
+                 << " was not rejected." << endl;
+            return 0;
+        }
+    }
+    cout << "Passed." << endl;
+
+    // All tests passed
+    cout << "All tests of this seventeenth function have been passed." << endl;
+    return POINTS[17];
+}
+
+// **************************************************************************
+// int test18()
+//   Checks undo and redo over several checkpointed steps: the items and
+//   the current item each one restores, that edits made before the first
+//   checkpoint are not recorded, that a new edit discards what could be
+//   redone, that insert_range and remove_if are undone as a whole, that a
+//   bound cursor stays on its item, and that clear_history and sort leave
+//   nothing to undo.
+//   Returns POINTS[18] if the tests are passed. Otherwise returns 0.
+// **************************************************************************
+int test18()
+{
+    double items1[5] = { 1, 2, 3, 4, 5 };
+    double items2[4] = { 2, 3, 4, 5 };
+    double items3[6] = { 1, 2, 3, 4, 5, 9 };
+    double items4[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    double items5[5] = { 1, 3, 5, 7, 9 };
+    double middle[3] = { 6, 7, 8 };
+
+    cout << "Attaching 1, 2, 3 before the first checkpoint (nothing to\n";
+    cout << "undo), then attaching 4 and 5 in one step and removing 1 in\n";
+    cout << "another." << endl;
+    sequence test;
+    test.attach(1);
+    test.attach(2);
+    test.attach(3);
+    if (test.undo())
+    {
+        cout << "    undo returned true before the first checkpoint." << endl;
+        return 0;
+    }
+    test.checkpoint();
+    test.attach(4);
+    test.attach(5);
+    test.checkpoint();
+    test.start();
+    test.remove_current();
+
+    cout << "Undoing the removal (the cursor should be back on 1)." << endl;
+    if (!test.undo() || !correct(test, 5, 0, items1))
+        return 0;
+    // (correct moved the cursor off the sequence)
+    cout << "Undoing the attaches (the cursor should be back on 3), then\n";
+    cout << "undoing once more (there is nothing left to undo)." << endl;
+    if (!test.undo() || test.undo() || !correct(test, 3, 2, items1))
+        return 0;
+
+    cout << "Redoing the attaches (there should be no current item, as when\n";
+    cout << "they were undone), then the removal (the cursor should be on 2,\n";
+    cout << "as when it was undone), then redoing once more." << endl;
+    if (!test.redo() || !correct(test, 5, 5, items1))
+        return 0;
+    if (!test.redo() || test.redo() || !correct(test, 4, 0, items2))
+        return 0;
+
+    cout << "Undoing the removal, then attaching 9 (nothing to redo)." << endl;
+    test.undo();
+    for (int i = 0; i < 4; i++)
+        test.advance();
+    test.attach(9);
+    if (test.redo() || !correct(test, 6, 5, items3))
+        return 0;
+
+    cout << "Inserting 6, 7, 8 before 9 with a cursor bound to 9, and\n";
+    cout << "undoing and redoing that as one step." << endl;
+    test.checkpoint();
+    sequence::cursor bound(test);
+    test.start();
+    for (int i = 0; i < 5; i++)
+    {
+        bound.advance();
+        test.advance();
+    }
+    test.insert_range(middle, middle + 3);
+    if (!bound.is_item() || bound.current() != 9)
+        return 0;
+    // (the current item is 8, the last one inserted, when it's undone)
+    if (!test.undo() || !bound.is_item() || bound.current() != 9
+        || !correct(test, 6, 5, items3))
+        return 0;
+    if (!test.redo() || !bound.is_item() || bound.current() != 9
+        || !correct(test, 9, 7, items4))
+        return 0;
+
+    cout << "Removing the even items in one step, then undoing and redoing."
+         << endl;
+    test.checkpoint();
+    test.remove_if(is_even);
+    if (!test.undo() || !correct(test, 9, 9, items4))
+        return 0;
+    if (!test.redo() || !correct(test, 5, 5, items5))
+        return 0;
+
+    cout << "Clearing the history, and sorting after a checkpoint (neither\n";
+    cout << "should leave anything to undo)." << endl;
+    test.clear_history();
+    if (test.undo())
+        return 0;
+    test.checkpoint();
+    test.attach(0);
+    test.sort();
+    if (test.undo())
+    {
+        cout << "    undo returned true." << endl;
+        return 0;
+    }
+
+    // All tests passed
+    cout << "All tests of this eighteenth function have been passed." << endl;
+    return POINTS[18];
+}
+
 int run_a_test(int number, const char message[], int test_function(), int max)
 {
     int result;
@@ -763,6 +1981,17 @@ int main()
     sum += run_a_test(5, DESCRIPTION[5], test5, POINTS[5]);
     sum += run_a_test(6, DESCRIPTION[6], test6, POINTS[6]);
     sum += run_a_test(7, DESCRIPTION[7], test7, POINTS[7]);
+    sum += run_a_test(8, DESCRIPTION[8], test8, POINTS[8]);
+    sum += run_a_test(9, DESCRIPTION[9], test9, POINTS[9]);
+    sum += run_a_test(10, DESCRIPTION[10], test10, POINTS[10]);
+    sum += run_a_test(11, DESCRIPTION[11], test11, POINTS[11]);
+    sum += run_a_test(12, DESCRIPTION[12], test12, POINTS[12]);
+    sum += run_a_test(13, DESCRIPTION[13], test13, POINTS[13]);
+    sum += run_a_test(14, DESCRIPTION[14], test14, POINTS[14]);
+    sum += run_a_test(15, DESCRIPTION[15], test15, POINTS[15]);
+    sum += run_a_test(16, DESCRIPTION[16], test16, POINTS[16]);
+    sum += run_a_test(17, DESCRIPTION[17], test17, POINTS[17]);
+    sum += run_a_test(18, DESCRIPTION[18], test18, POINTS[18]);
 
     cout << "Your sequence implementation has scored\n";
     cout << sum << " points out of the " << POINTS[0];
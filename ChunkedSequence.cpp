@@ -0,0 +1,239 @@
+// FILE: ChunkedSequence.cpp
+// CLASS IMPLEMENTED: chunked_sequence (see ChunkedSequence.h for
+//                    documentation)
+// INVARIANT for the chunked_sequence ADT:
+//   1. The number of items in the chunked_sequence is in the member
+//      variable used.
+//   2. The items are stored, in order, in the dynamic arrays (blocks)
+//      pointed to by blocks[0], blocks[1], ..., each of size
+//      BLOCK_CAPACITY; counts[b] items are stored in blocks[b][0]
+//      through blocks[b][counts[b]-1], and we don't care what's in
+//      the rest of a block. blocks and counts have the same size.
+//   3. No block is empty (so an empty chunked_sequence has no blocks
+//      at all); blocks that become sparse (less than a quarter full)
+//      are merged with a neighbor when the two fit in one block, and
+//      a full block is split in half before inserting into it.
+//   4. The current item is item current_offset of block
+//      current_block. If there is no valid current item, then
+//      current_block is blocks.size() and current_offset is 0.
+//      NOTE: current_offset < counts[current_block] whenever
+//            current_block < blocks.size(), so advance only has to
+//            roll over into the next block when it reaches the end
+//            of the current one.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   void insert_at(size_type block, size_type offset,
+//                  const value_type& entry)
+//    Pre:  Either there are no blocks and block == offset == 0, or
+//      block < blocks.size() and offset <= counts[block].
+//    Post: entry has been inserted before item offset of block (or
+//      at its end if offset == counts[block]), splitting the block
+//      first if it was full, and is now the current item.
+//
+//   void merge_if_sparse(size_type block)
+//    Pre:  block < blocks.size()
+//    Post: If block is less than a quarter full and fits together
+//      with its next (or else previous) neighbor in one block, the
+//      two have been merged; the current item is unchanged.
+//
+//   void clear()
+//    Pre:  none
+//    Post: All blocks have been freed and the chunked_sequence is
+//      empty.
+
+#include <cassert>
+#include <algorithm>
+#include "ChunkedSequence.h"
+using namespace std;
+
+namespace CS3358_FA2021
+{
+   // CONSTRUCTORS and DESTRUCTOR
+   chunked_sequence::chunked_sequence()
+      : used(0), current_block(0), current_offset(0) { }
+
+   chunked_sequence::chunked_sequence(const chunked_sequence& source)
+      : counts(source.counts), used(source.used),
+        current_block(source.current_block),
+        current_offset(source.current_offset)
+   {
+      for (size_type b = 0; b < source.blocks.size(); ++b)
+      {
+         blocks.push_back(new value_type [BLOCK_CAPACITY]);
+         copy(source.blocks[b], source.blocks[b] + counts[b], blocks[b]);
+      }
+   }
+
+   chunked_sequence::~chunked_sequence()
+   {
+      clear();
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void chunked_sequence::start()
+   {
+      current_block = 0;
+      current_offset = 0;
+   }
+
+   void chunked_sequence::advance()
+   {
+      if (is_item() && ++current_offset == counts[current_block])
+      {
+         ++current_block;
+         current_offset = 0;
+      }
+   }
+
+   void chunked_sequence::insert(const value_type& entry)
+   {
+      if (is_item())
+         insert_at(current_block, current_offset, entry);
+      else
+         insert_at(0, 0, entry);
+   }
+
+   void chunked_sequence::attach(const value_type& entry)
+   {
+      if (is_item())
+         insert_at(current_block, current_offset + 1, entry);
+      else if (blocks.empty())
+         insert_at(0, 0, entry);
+      else
+         insert_at(blocks.size() - 1, counts.back(), entry);
+   }
+
+   void chunked_sequence::remove_current()
+   {
+      assert(is_item());
+      size_type b = current_block;
+      value_type* block = blocks[b];
+      copy(block + current_offset + 1, block + counts[b],
+           block + current_offset);
+      --counts[b];
+      --used;
+      if (counts[b] == 0)
+      {
+         // the item after the removed one is now first in block b
+         delete [] block;
+         blocks.erase(blocks.begin() + b);
+         counts.erase(counts.begin() + b);
+         current_offset = 0;
+         if (b > 0 && b < blocks.size())
+            merge_if_sparse(b - 1);
+         return;
+      }
+      if (current_offset == counts[b])
+      {
+         ++current_block;
+         current_offset = 0;
+      }
+      merge_if_sparse(b);
+   }
+
+   chunked_sequence& chunked_sequence::operator=(const chunked_sequence& source)
+   {
+      if (this != &source)
+      {
+         chunked_sequence copy_of_source(source);
+         blocks.swap(copy_of_source.blocks);
+         counts.swap(copy_of_source.counts);
+         used = source.used;
+         current_block = source.current_block;
+         current_offset = source.current_offset;
+      }
+      return *this;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   chunked_sequence::size_type chunked_sequence::size() const
+   {
+      return used;
+   }
+
+   bool chunked_sequence::is_item() const
+   {
+      return current_block < blocks.size();
+   }
+
+   chunked_sequence::value_type chunked_sequence::current() const
+   {
+      assert(is_item());
+      return blocks[current_block][current_offset];
+   }
+
+   // PRIVATE HELPER FUNCTIONS
+   void chunked_sequence::insert_at(size_type block, size_type offset,
+                                    const value_type& entry)
+   {
+      if (blocks.empty())
+      {
+         blocks.push_back(new value_type [BLOCK_CAPACITY]);
+         counts.push_back(0);
+      }
+      if (counts[block] == BLOCK_CAPACITY)
+      {
+         const size_type half = BLOCK_CAPACITY / 2;
+         value_type* upper = new value_type [BLOCK_CAPACITY];
+         copy(blocks[block] + half, blocks[block] + BLOCK_CAPACITY, upper);
+         blocks.insert(blocks.begin() + block + 1, upper);
+         counts.insert(counts.begin() + block + 1, BLOCK_CAPACITY - half);
+         counts[block] = half;
+         if (offset > half)
+         {
+            ++block;
+            offset -= half;
+         }
+      }
+      value_type* items = blocks[block];
+      copy_backward(items + offset, items + counts[block],
+                    items + counts[block] + 1);
+      items[offset] = entry;
+      ++counts[block];
+      ++used;
+      current_block = block;
+      current_offset = offset;
+   }
+
+   void chunked_sequence::merge_if_sparse(size_type block)
+   {
+      if (counts[block] >= BLOCK_CAPACITY / 4)
+         return;
+      size_type left;
+      if (block + 1 < blocks.size()
+          && counts[block] + counts[block + 1] <= BLOCK_CAPACITY)
+         left = block;
+      else if (block > 0
+               && counts[block - 1] + counts[block] <= BLOCK_CAPACITY)
+         left = block - 1;
+      else
+         return;
+
+      // append block left + 1 to block left
+      size_type right = left + 1;
+      copy(blocks[right], blocks[right] + counts[right],
+           blocks[left] + counts[left]);
+      if (current_block == right)
+      {
+         current_block = left;
+         current_offset += counts[left];
+      }
+      else if (current_block > right)
+         --current_block;
+      counts[left] += counts[right];
+      delete [] blocks[right];
+      blocks.erase(blocks.begin() + right);
+      counts.erase(counts.begin() + right);
+   }
+
+   void chunked_sequence::clear()
+   {
+      for (size_type b = 0; b < blocks.size(); ++b)
+         delete [] blocks[b];
+      blocks.clear();
+      counts.clear();
+      used = 0;
+      current_block = 0;
+      current_offset = 0;
+   }
+}
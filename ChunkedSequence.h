@@ -0,0 +1,134 @@
+// FILE: ChunkedSequence.h
+// CLASS PROVIDED: chunked_sequence (part of the namespace CS3358_FA2021)
+//
+// A chunked_sequence is a sequence (see Sequence.h) meant for very
+// large sequences that are edited at arbitrary positions. The items
+// are kept in a list of fixed-size blocks, so inserting or removing
+// an item moves at most one block's worth of items (BLOCK_CAPACITY)
+// no matter where the current item is or how long the sequence is.
+// The trade-off is that the items are not stored contiguously.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the chunked_sequence class:
+//   typedef ____ value_type
+//    chunked_sequence::value_type is the data type of the items in the
+//    chunked_sequence. It may be any of the C++ built-in types (int,
+//    char, etc.), or a class with a default constructor, an assignment
+//    operator, and a copy constructor.
+//
+//   typedef ____ size_type
+//    chunked_sequence::size_type is the data type of any variable that
+//    keeps track of how many items are in a chunked_sequence.
+//
+//   static const size_type BLOCK_CAPACITY = _____
+//    chunked_sequence::BLOCK_CAPACITY is the # of items a block holds
+//    (chosen so a block of doubles is 4 KB).
+//
+// CONSTRUCTOR for the chunked_sequence class:
+//   chunked_sequence()
+//    Pre:  none
+//    Post: The chunked_sequence has been initialized as an empty
+//      chunked_sequence.
+//
+// MODIFICATION MEMBER FUNCTIONS for the chunked_sequence class:
+//   void start()
+//    Pre:  none
+//    Post: The first item on the chunked_sequence becomes the current
+//      item (but if the chunked_sequence is empty, then there is no
+//      current item). O(1).
+//
+//   void advance()
+//    Pre:  is_item returns true.
+//    Post: If the current item was already the last item in the
+//      chunked_sequence, then there is no longer any current item.
+//      Otherwise, the new current item is the item immediately after
+//      the original current item. O(1).
+//
+//   void insert(const value_type& entry)
+//    Pre:  none
+//    Post: A new copy of entry has been inserted in the
+//      chunked_sequence before the current item. If there was no
+//      current item, then the new entry has been inserted at the
+//      front of the chunked_sequence. In either case, the newly
+//      inserted item is now the current item of the chunked_sequence.
+//
+//   void attach(const value_type& entry)
+//    Pre:  none
+//    Post: A new copy of entry has been inserted in the
+//      chunked_sequence after the current item. If there was no
+//      current item, then the new entry has been attached to the end
+//      of the chunked_sequence. In either case, the newly inserted
+//      item is now the current item of the chunked_sequence.
+//
+//   void remove_current()
+//    Pre:  is_item returns true.
+//    Post: The current item has been removed from the
+//      chunked_sequence, and the item after this (if there is one) is
+//      now the new current item. If the current item was already the
+//      last item in the chunked_sequence, then there is no longer any
+//      current item.
+//
+// CONSTANT MEMBER FUNCTIONS for the chunked_sequence class:
+//   size_type size() const
+//    Pre:  none
+//    Post: The return value is the number of items in the
+//      chunked_sequence.
+//
+//   bool is_item() const
+//    Pre:  none
+//    Post: A true return value indicates that there is a valid
+//      "current" item that may be retrieved by activating the current
+//      member function (listed below). A false return value indicates
+//      that there is no valid current item. O(1).
+//
+//   value_type current() const
+//    Pre:  is_item() returns true.
+//    Post: The item returned is the current item in the
+//      chunked_sequence. O(1).
+//
+// VALUE SEMANTICS for the chunked_sequence class:
+//   Assignments and the copy constructor may be used with
+//   chunked_sequence objects.
+
+#ifndef CHUNKED_SEQUENCE_H
+#define CHUNKED_SEQUENCE_H
+#include <cstdlib>  // provides size_t
+#include <vector>
+
+namespace CS3358_FA2021
+{
+   class chunked_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type BLOCK_CAPACITY = 512;
+      // CONSTRUCTORS and DESTRUCTOR
+      chunked_sequence();
+      chunked_sequence(const chunked_sequence& source);
+      ~chunked_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      chunked_sequence& operator=(const chunked_sequence& source);
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      std::vector<value_type*> blocks;
+      std::vector<size_type> counts;
+      size_type used;
+      size_type current_block;
+      size_type current_offset;
+      void insert_at(size_type block, size_type offset,
+                     const value_type& entry);
+      void merge_if_sparse(size_type block);
+      void clear();
+   };
+}
+
+#endif
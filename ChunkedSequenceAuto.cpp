@@ -0,0 +1,558 @@
+// FILE: ChunkedSequenceAuto.cpp
+// A non-interactive test program for the chunked_sequence class.
+//
+// DESCRIPTION:
+// Each function of this program tests part of the chunked_sequence
+// class, returning some number of points to indicate how much of the
+// test was passed. The tests fill and empty sequences across the
+// BLOCK_CAPACITY (512 item) block boundaries, so that blocks get split
+// and merged at the front, the back and in the middle, and compare the
+// sequence with a vector after every single operation.
+// A description and result of each test is printed to cout.
+// Maximum number of points awarded by this program is determined by the
+// constants POINTS[1], POINTS[2]...
+
+#include <iostream>           // provides cout.
+#include <cstdlib>            // provides size_t.
+#include <vector>             // provides vector.
+#include "ChunkedSequence.h"  // provides the chunked_sequence class.
+using namespace std;
+using namespace CS3358_FA2021;
+
+// Descriptions and points for each of the tests:
+const size_t MANY_TESTS = 6;
+const int POINTS[MANY_TESTS+1] =
+{
+    18,  // Total points for all tests.
+     3,  // Test 1 points
+     3,  // Test 2 points
+     3,  // Test 3 points
+     3,  // Test 4 points
+     3,  // Test 5 points
+     3   // Test 6 points
+};
+const char DESCRIPTION[MANY_TESTS+1][256] =
+{
+    "tests for chunked_sequence class",
+    "Testing attach at the end across block boundaries",
+    "Testing insert at the front across block boundaries",
+    "Testing insert and attach in the middle of full blocks",
+    "Testing remove_current in the middle (blocks merge)",
+    "Testing remove_current at the front and the back",
+    "Testing a random mix of operations, copies and assignments"
+};
+
+const size_t B = chunked_sequence::BLOCK_CAPACITY;
+
+
+// The model of a chunked_sequence that the tests check it against:
+// its items and the index of the current item (items.size() if there
+// is no current item).
+struct model
+{
+    vector<double> items;
+    size_t cursor;
+
+    model() : cursor(0) { }
+    void insert(double entry)
+    {
+        if (cursor == items.size())
+            cursor = 0;
+        items.insert(items.begin() + cursor, entry);
+    }
+    void attach(double entry)
+    {
+        cursor = (cursor == items.size() ? items.size() : cursor + 1);
+        items.insert(items.begin() + cursor, entry);
+    }
+    void remove_current()
+    {
+        items.erase(items.begin() + cursor);
+    }
+};
+
+
+// **************************************************************************
+// bool matches(const chunked_sequence& test, const model& expected)
+//   Postcondition: A return value of true indicates that test has the
+//   size, the items (in order) and the current item of expected.
+//   Otherwise the return value is false, and the first difference
+//   found has been printed to cout.
+//   NOTE: The items are walked in a copy of test, so test's cursor is
+//   left where it was (and the copy constructor is tested too).
+// **************************************************************************
+bool matches(const chunked_sequence& test, const model& expected)
+{
+    size_t s = expected.items.size();
+    if (test.size() != s)
+    {
+        cout << "\n    size() should be " << s << ", but it was "
+             << test.size() << ".\n";
+        return false;
+    }
+    bool has_cursor = (expected.cursor < s);
+    if (test.is_item() != has_cursor)
+    {
+        cout << "\n    is_item() should be " << (has_cursor ? "true" : "false")
+             << " with " << s << " items.\n";
+        return false;
+    }
+    if (has_cursor && test.current() != expected.items[expected.cursor])
+    {
+        cout << "\n    The current item should be item ["
+             << expected.cursor << "], " << expected.items[expected.cursor]
+             << ", but it was " << test.current() << ".\n";
+        return false;
+    }
+
+    chunked_sequence copy(test);
+    copy.start();
+    for (size_t i = 0; i < s; ++i)
+    {
+        if (!copy.is_item())
+        {
+            cout << "\n    The cursor fell off after " << i << " of "
+                 << s << " items.\n";
+            return false;
+        }
+        if (copy.current() != expected.items[i])
+        {
+            cout << "\n    Item [" << i << "] should be " << expected.items[i]
+                 << ", but it was " << copy.current() << ".\n";
+            return false;
+        }
+        copy.advance();
+    }
+    if (copy.is_item())
+    {
+        cout << "\n    is_item() is still true after the last item.\n";
+        return false;
+    }
+    return true;
+}
+
+// Prints the result of one phase of a test and returns passed.
+bool report(bool passed)
+{
+    cout << (passed ? "Passed." : "Failed.") << endl;
+    return passed;
+}
+
+// Moves test's cursor (and expected's) to item [spot].
+void seat(chunked_sequence& test, model& expected, size_t spot)
+{
+    test.start();
+    for (size_t i = 0; i < spot; ++i)
+        test.advance();
+    expected.cursor = spot;
+}
+
+
+// **************************************************************************
+// int test1()
+//   Attaches 4 * BLOCK_CAPACITY + 1 items one at a time at the end, so
+//   the last block fills and splits four times.
+//   Returns POINTS[1] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test1()
+{
+    chunked_sequence test;
+    model expected;
+
+    cout << "Attaching " << 4 * B + 1 << " items at the end, checking the\n";
+    cout << "whole sequence after each one...";
+    cout.flush();
+    bool passed = matches(test, expected);
+    for (size_t i = 0; passed && i < 4 * B + 1; ++i)
+    {
+        test.attach(double(i));
+        expected.attach(double(i));
+        passed = matches(test, expected);
+    }
+    if (!report(passed))
+        return 0;
+
+    cout << "Advancing from the start over every block boundary...";
+    cout.flush();
+    test.start();
+    expected.cursor = 0;
+    for (size_t i = 0; passed && i < 4 * B + 1; ++i)
+    {
+        test.advance();
+        ++expected.cursor;
+        passed = matches(test, expected);
+    }
+    if (!report(passed))
+        return 0;
+
+    cout << "All tests of this first function have been passed." << endl;
+    return POINTS[1];
+}
+
+
+// **************************************************************************
+// int test2()
+//   Inserts 3 * BLOCK_CAPACITY items one at a time at the front (first
+//   with no current item, then with the cursor on the first item), so
+//   the first block fills and splits again and again.
+//   Returns POINTS[2] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test2()
+{
+    chunked_sequence test;
+    model expected;
+
+    cout << "Inserting " << 3 * B << " items at the front, checking the\n";
+    cout << "whole sequence after each one...";
+    cout.flush();
+    bool passed = true;
+    for (size_t i = 0; passed && i < 3 * B; ++i)
+    {
+        test.insert(double(i));
+        expected.insert(double(i));
+        passed = matches(test, expected);
+    }
+    if (!report(passed))
+        return 0;
+
+    cout << "Moving off the end and inserting " << B << " more (which go\n";
+    cout << "to the front)...";
+    cout.flush();
+    for (size_t i = 0; passed && i < B; ++i)
+    {
+        while (test.is_item())
+            test.advance();
+        expected.cursor = expected.items.size();
+        test.insert(-double(i));
+        expected.insert(-double(i));
+        passed = matches(test, expected);
+    }
+    if (!report(passed))
+        return 0;
+
+    cout << "All tests of this second function have been passed." << endl;
+    return POINTS[2];
+}
+
+
+// **************************************************************************
+// int test3()
+//   Inserts and attaches runs of BLOCK_CAPACITY items at cursors in the
+//   first half, the second half and at the very end of full blocks, so
+//   the blocks split with the new item landing in either half.
+//   Returns POINTS[3] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test3()
+{
+    // spots in the first half, the second half, the last item and the
+    // first item of a full block
+    const size_t SPOTS[] = { B / 4, B + 3 * B / 4, 3 * B - 1, 3 * B };
+    const size_t MANY_SPOTS = sizeof SPOTS / sizeof SPOTS[0];
+
+    for (size_t k = 0; k < 2 * MANY_SPOTS; ++k)
+    {
+        bool attaching = (k >= MANY_SPOTS);
+        size_t spot = SPOTS[k % MANY_SPOTS];
+        chunked_sequence test;
+        model expected;
+        for (size_t i = 0; i < 4 * B; ++i)
+        {
+            test.attach(double(i));
+            expected.attach(double(i));
+        }
+
+        cout << (attaching ? "Attaching " : "Inserting ") << B
+             << " items with the cursor starting at item [" << spot
+             << "]\nof " << 4 * B << ", checking after each one...";
+        cout.flush();
+        seat(test, expected, spot);
+        bool passed = matches(test, expected);
+        for (size_t i = 0; passed && i < B; ++i)
+        {
+            double entry = 10000.0 + i;
+            if (attaching)
+            {
+                test.attach(entry);
+                expected.attach(entry);
+            }
+            else
+            {
+                test.insert(entry);
+                expected.insert(entry);
+            }
+            passed = matches(test, expected);
+        }
+        if (!report(passed))
+            return 0;
+    }
+
+    cout << "All tests of this third function have been passed." << endl;
+    return POINTS[3];
+}
+
+
+// **************************************************************************
+// int test4()
+//   Removes items from the middle of a sequence of blocks (one run of
+//   consecutive items, then every other item, then items in a block
+//   whose next neighbor is full), so blocks become sparse and are
+//   merged with their next or previous neighbors.
+//   Returns POINTS[4] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test4()
+{
+    chunked_sequence test;
+    model expected;
+    for (size_t i = 0; i < 6 * B; ++i)
+    {
+        test.attach(double(i));
+        expected.attach(double(i));
+    }
+
+    cout << "Removing " << 2 * B << " consecutive items starting at item ["
+         << B + B / 2 << "],\nchecking after each one...";
+    cout.flush();
+    seat(test, expected, B + B / 2);
+    bool passed = true;
+    for (size_t i = 0; passed && i < 2 * B; ++i)
+    {
+        test.remove_current();
+        expected.remove_current();
+        passed = matches(test, expected);
+    }
+    if (!report(passed))
+        return 0;
+
+    cout << "Removing every other item from the front to the end,\n";
+    cout << "checking after each removal...";
+    cout.flush();
+    seat(test, expected, 0);
+    while (passed && test.is_item())
+    {
+        test.remove_current();
+        expected.remove_current();
+        passed = matches(test, expected);
+        if (passed && test.is_item())
+        {
+            test.advance();
+            ++expected.cursor;
+            passed = matches(test, expected);
+        }
+    }
+    if (!report(passed))
+        return 0;
+
+    cout << "Attaching " << B << " items at the end of what is left...";
+    cout.flush();
+    for (size_t i = 0; passed && i < B; ++i)
+    {
+        test.attach(-double(i));
+        expected.attach(-double(i));
+        passed = matches(test, expected);
+    }
+    if (!report(passed))
+        return 0;
+
+    // Attaching 6 * B items leaves blocks of B / 2 items followed by one
+    // full block, so the block before the full one can only be merged
+    // with its previous neighbor: once with the cursor inside it, and
+    // once with the cursor already moved on into the full block.
+    for (int at_block_end = 0; at_block_end <= 1; ++at_block_end)
+    {
+        test = chunked_sequence();
+        expected = model();
+        for (size_t i = 0; i < 6 * B; ++i)
+        {
+            test.attach(double(i));
+            expected.attach(double(i));
+        }
+
+        cout << "Removing " << B / 2 - 1 << " items from "
+             << (at_block_end ? "the end" : "the middle")
+             << " of the block before the\nfull last block, checking after"
+             << " each one...";
+        cout.flush();
+        size_t spot = 6 * B - B - B / 2 + B / 8;
+        for (size_t i = 0; passed && i < B / 2 - 1; ++i)
+        {
+            if (at_block_end)
+                spot = expected.items.size() - B - 1;
+            seat(test, expected, spot);
+            test.remove_current();
+            expected.remove_current();
+            passed = matches(test, expected);
+        }
+        if (!report(passed))
+            return 0;
+    }
+
+    cout << "All tests of this fourth function have been passed." << endl;
+    return POINTS[4];
+}
+
+
+// **************************************************************************
+// int test5()
+//   Empties a sequence of several blocks by removing the last item over
+//   and over, and another by removing the first item over and over, and
+//   then refills the empty sequences.
+//   Returns POINTS[5] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test5()
+{
+    bool passed = true;
+    for (int from_front = 0; from_front <= 1; ++from_front)
+    {
+        chunked_sequence test;
+        model expected;
+        for (size_t i = 0; i < 3 * B + B / 2; ++i)
+        {
+            test.attach(double(i));
+            expected.attach(double(i));
+        }
+
+        cout << "Removing all " << expected.items.size() << " items from the "
+             << (from_front ? "front" : "back")
+             << ",\nchecking after each one...";
+        cout.flush();
+        while (passed && !expected.items.empty())
+        {
+            seat(test, expected, from_front ? 0 : expected.items.size() - 1);
+            test.remove_current();
+            expected.remove_current();
+            passed = matches(test, expected);
+        }
+        if (!report(passed))
+            return 0;
+
+        cout << "Attaching " << B + 1 << " items to the empty sequence...";
+        cout.flush();
+        for (size_t i = 0; passed && i < B + 1; ++i)
+        {
+            test.attach(double(i));
+            expected.attach(double(i));
+            passed = matches(test, expected);
+        }
+        if (!report(passed))
+            return 0;
+    }
+
+    cout << "All tests of this fifth function have been passed." << endl;
+    return POINTS[5];
+}
+
+
+// **************************************************************************
+// int test6()
+//   Runs a long random mix of start, advance, insert, attach and
+//   remove_current (weighted so the sequence grows to a few blocks and
+//   shrinks again), checking after each one, and every so often copies
+//   or assigns the sequence and carries on with the copy.
+//   Returns POINTS[6] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test6()
+{
+    const int MANY_STEPS = 20000;
+    chunked_sequence test;
+    model expected;
+    unsigned long state = 3358;
+
+    cout << "Running " << MANY_STEPS << " random operations, checking after\n";
+    cout << "each one...";
+    cout.flush();
+    bool passed = true;
+    for (int step = 0; passed && step < MANY_STEPS; ++step)
+    {
+        state = (state * 1103515245ul + 12345ul) % 2147483648ul;
+        int choice = int(state >> 16) % 100;
+        // grow for the first half of the run, shrink for the second
+        int removes = (step % 10000 < 5000 ? 25 : 60);
+        double entry = double(step);
+        if (choice < 2)
+        {
+            test.start();
+            expected.cursor = 0;
+        }
+        else if (choice < 10 && test.is_item())
+        {
+            test.advance();
+            ++expected.cursor;
+        }
+        else if (choice < 10 + removes && test.is_item())
+        {
+            test.remove_current();
+            expected.remove_current();
+        }
+        else if (choice % 2 == 0)
+        {
+            test.insert(entry);
+            expected.insert(entry);
+        }
+        else
+        {
+            test.attach(entry);
+            expected.attach(entry);
+        }
+
+        if (step % 997 == 0)
+        {
+            chunked_sequence copy(test);
+            test = chunked_sequence();
+            test = copy;
+        }
+        passed = matches(test, expected);
+    }
+    if (!report(passed))
+        return 0;
+
+    cout << "All tests of this sixth function have been passed." << endl;
+    return POINTS[6];
+}
+
+
+int run_a_test(int number, const char message[], int test_function(), int max)
+{
+    int result;
+
+    cout << endl << "START OF TEST " << number << ":" << endl;
+    cout << message << " (" << max << " points)." << endl;
+    result = test_function();
+    if (result > 0)
+    {
+        cout << "Test " << number << " got " << result << " points";
+        cout << " out of a possible " << max << "." << endl;
+    }
+    else
+        cout << "Test " << number << " failed." << endl;
+    cout << "END OF TEST " << number << "." << endl << endl;
+
+    return result;
+}
+
+
+// **************************************************************************
+// int main()
+//   The main program calls all tests and prints the sum of all points
+//   earned from the tests.
+// **************************************************************************
+int main()
+{
+    int sum = 0;
+
+
+    cout << "Running " << DESCRIPTION[0] << endl;
+
+    sum += run_a_test(1, DESCRIPTION[1], test1, POINTS[1]);
+    sum += run_a_test(2, DESCRIPTION[2], test2, POINTS[2]);
+    sum += run_a_test(3, DESCRIPTION[3], test3, POINTS[3]);
+    sum += run_a_test(4, DESCRIPTION[4], test4, POINTS[4]);
+    sum += run_a_test(5, DESCRIPTION[5], test5, POINTS[5]);
+    sum += run_a_test(6, DESCRIPTION[6], test6, POINTS[6]);
+
+    cout << "Your chunked_sequence implementation has scored\n";
+    cout << sum << " points out of the " << POINTS[0];
+    cout << " points based on this test program.\n";
+
+    return EXIT_SUCCESS;
+
+}
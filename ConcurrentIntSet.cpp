@@ -0,0 +1,237 @@
+// FILE: ConcurrentIntSet.cpp
+//       Implementation file for the ConcurrentIntSet class
+//       (See ConcurrentIntSet.h for documentation.)
+// INVARIANT for the ConcurrentIntSet class:
+// (1) current references the published version, a dynamically
+//     allocated IntSet that is never modified after publication. Its
+//     filter (if any) has been refreshed before publication, so the
+//     IntSet::contains calls of concurrent readers never rebuild it.
+// (2) hazards[s].pointer is the version the reader thread owning
+//     slot s is reading (0 if it is not reading); a version that
+//     appears in any hazard slot must not be deleted.
+// (3) retired holds the versions that have been replaced but could
+//     not be deleted yet because some hazard slot still referenced
+//     them; retired is only touched while holding writerLock.
+// (4) Versions are only replaced or deleted while holding writerLock,
+//     so a reader thread that holds writerLock (because no hazard slot
+//     was free for it) can read current without announcing it.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   const IntSet* acquire(int& slot) const
+//     Pre:  The calling thread is not already reading the invoking
+//           ConcurrentIntSet.
+//     Post: The published version has been announced in the calling
+//           thread's hazard slot, whose index is stored in slot, and
+//           is returned; it stays valid until release(slot) is
+//           called. If all MAX_READERS slots are taken by other
+//           threads, slot is NO_SLOT and writerLock has been locked
+//           instead (so the reader waits for any writer, and writers
+//           wait for it).
+//   void release(int slot) const
+//     Pre:  slot was set by the calling thread's last acquire().
+//     Post: The calling thread's hazard slot has been cleared (or
+//           writerLock unlocked, if acquire() locked it).
+//   void swapIn(const IntSet* newVersion)
+//     Pre:  writerLock is held; newVersion is dynamically allocated.
+//     Post: newVersion's filter has been refreshed, newVersion has
+//           been published and the replaced version
+//           (plus any earlier retired version) has been deleted
+//           unless a hazard slot still references it, in which case
+//           it is kept in retired for a later writer to delete.
+
+#include "ConcurrentIntSet.h"
+#include <algorithm>
+using namespace std;
+
+// Reader slots are handed out per thread, and given back to the pool
+// when the thread exits so long-running programs don't run out. A
+// thread that finds the pool empty gets NO_SLOT (and reads under the
+// writer lock); it tries again on its next read.
+namespace
+{
+   const int NO_SLOT = -1;
+   mutex slotPoolLock;
+   vector<int> freeSlots;
+   int nextSlot = 0;
+
+   struct ReaderSlot
+   {
+      int index;
+      ReaderSlot() : index(NO_SLOT) { claim(); }
+      void claim()
+      {
+         lock_guard<mutex> guard(slotPoolLock);
+         if (!freeSlots.empty())
+         {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+         }
+         else if (nextSlot < ConcurrentIntSet::MAX_READERS)
+            index = nextSlot++;
+      }
+      ~ReaderSlot()
+      {
+         if (index == NO_SLOT)
+            return;
+         lock_guard<mutex> guard(slotPoolLock);
+         freeSlots.push_back(index);
+      }
+   };
+
+   int readerSlot()
+   {
+      static thread_local ReaderSlot slot;
+      if (slot.index == NO_SLOT)
+         slot.claim();
+      return slot.index;
+   }
+}
+
+ConcurrentIntSet::ConcurrentIntSet() : current(new IntSet)
+{
+   for (int i = 0; i < MAX_READERS; ++i)
+      hazards[i].pointer.store(0);
+}
+
+ConcurrentIntSet::ConcurrentIntSet(const IntSet& initial)
+   : current(new IntSet(initial))
+{
+   current.load()->refreshFilter();
+   for (int i = 0; i < MAX_READERS; ++i)
+      hazards[i].pointer.store(0);
+}
+
+ConcurrentIntSet::~ConcurrentIntSet()
+{
+   delete current.load();
+   for (size_t i = 0; i < retired.size(); ++i)
+      delete retired[i];
+}
+
+const IntSet* ConcurrentIntSet::acquire(int& slot) const
+{
+   slot = readerSlot();
+   if (slot == NO_SLOT)
+   {
+      // no hazard slot to announce in: hold off writers instead
+      writerLock.lock();
+      return current.load();
+   }
+   atomic<const IntSet*>& hazard = hazards[slot].pointer;
+   const IntSet* version = current.load();
+   for (;;)
+   {
+      hazard.store(version);
+      // if current still holds version after the announcement, any
+      // writer that replaces it from now on will see our hazard
+      const IntSet* check = current.load();
+      if (check == version)
+         return version;
+      version = check;
+   }
+}
+
+void ConcurrentIntSet::release(int slot) const
+{
+   if (slot == NO_SLOT)
+      writerLock.unlock();
+   else
+      hazards[slot].pointer.store(0);
+}
+
+bool ConcurrentIntSet::contains(int anInt) const
+{
+   int slot;
+   bool found = acquire(slot)->contains(anInt);
+   release(slot);
+   return found;
+}
+
+int ConcurrentIntSet::size() const
+{
+   int slot;
+   int count = acquire(slot)->size();
+   release(slot);
+   return count;
+}
+
+IntSet ConcurrentIntSet::snapshot() const
+{
+   int slot;
+   IntSet copy(*acquire(slot));
+   release(slot);
+   return copy;
+}
+
+void ConcurrentIntSet::swapIn(const IntSet* newVersion)
+{
+   newVersion->refreshFilter();
+   retired.push_back(current.exchange(newVersion));
+
+   vector<const IntSet*> inUse;
+   for (int i = 0; i < MAX_READERS; ++i)
+   {
+      const IntSet* hazard = hazards[i].pointer.load();
+      if (hazard != 0)
+         inUse.push_back(hazard);
+   }
+   sort(inUse.begin(), inUse.end());
+
+   size_t kept = 0;
+   for (size_t i = 0; i < retired.size(); ++i)
+   {
+      if (binary_search(inUse.begin(), inUse.end(), retired[i]))
+         retired[kept++] = retired[i];
+      else
+         delete retired[i];
+   }
+   retired.resize(kept);
+}
+
+void ConcurrentIntSet::update(const IntSet& toAdd, const IntSet& toRemove)
+{
+   lock_guard<mutex> guard(writerLock);
+   const IntSet* version = current.load();
+
+   // (version + toAdd) - toRemove in one merge pass over the three
+   // sorted arrays, straight into the new version
+   IntSet* next = new IntSet(version->used + toAdd.used);
+   const int* a = version->data;
+   const int* aEnd = a + version->used;
+   const int* b = toAdd.data;
+   const int* bEnd = b + toAdd.used;
+   const int* r = toRemove.data;
+   const int* rEnd = r + toRemove.used;
+   int* out = next->data;
+   while (a != aEnd || b != bEnd)
+   {
+      int item;
+      if (b == bEnd || (a != aEnd && *a < *b))
+         item = *a++;
+      else
+      {
+         if (a != aEnd && *a == *b)
+            ++a;
+         item = *b++;
+      }
+      while (r != rEnd && *r < item)
+         ++r;
+      if (r == rEnd || *r != item)
+         *out++ = item;
+   }
+   next->used = int(out - next->data);
+   next->rehash();
+   // readers of the new version get the same filtering as the old
+   if (version->filter != 0)
+   {
+      next->filterBitsPerElement = version->filterBitsPerElement;
+      next->rebuildFilter();
+   }
+   swapIn(next);
+}
+
+void ConcurrentIntSet::publish(const IntSet& replacement)
+{
+   lock_guard<mutex> guard(writerLock);
+   swapIn(new IntSet(replacement));
+}
@@ -0,0 +1,103 @@
+// FILE: ConcurrentIntSet.h - header file for ConcurrentIntSet class
+// CLASS PROVIDED: ConcurrentIntSet (a set of int values that many
+//                 threads may read while occasional writers publish
+//                 new versions of it)
+//
+// CONSTANT
+//   static const int MAX_READERS = ____
+//     ConcurrentIntSet::MAX_READERS is the highest # of threads that
+//     can read ConcurrentIntSet's without locking at the same time (a
+//     thread gives its reader slot back when it exits); any more
+//     still read correctly, but take a lock to do it.
+//
+// CONSTRUCTORS
+//   ConcurrentIntSet()
+//     Post: The invoking ConcurrentIntSet is initialized to publish
+//           an empty set.
+//   ConcurrentIntSet(const IntSet& initial)
+//     Post: The invoking ConcurrentIntSet is initialized to publish
+//           a copy of initial.
+//
+// CONSTANT MEMBER FUNCTIONS (READERS - safe to call from any thread)
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: true is returned if the currently published version has
+//           anInt as an element, otherwise false is returned.
+//     Note: Readers never lock or block: they announce the version
+//           they are about to read in their own hazard slot, which
+//           is what keeps writers from reclaiming it. The only retry
+//           happens when a writer publishes during the announcement.
+//           The exception is a thread that reads while MAX_READERS
+//           other threads hold reader slots: it reads under the
+//           writers' lock until a slot is given back.
+//   int size() const
+//     Pre:  (none)
+//     Post: Number of elements in the currently published version is
+//           returned.
+//   IntSet snapshot() const
+//     Pre:  (none)
+//     Post: A copy of the currently published version is returned
+//           (useful for a consistent series of queries).
+//
+// MODIFICATION MEMBER FUNCTIONS (WRITERS - serialized internally)
+//   void update(const IntSet& toAdd, const IntSet& toRemove)
+//     Pre:  (none)
+//     Post: A new version equal to the current version with all
+//           elements of toAdd added and then all elements of
+//           toRemove removed has been published. Readers that
+//           started before see the old version; readers that start
+//           after see the new one.
+//     Note: Batch changes into one update; each update copies the
+//           set once. If the current version has a Bloom filter (see
+//           IntSet::enableFilter), the new version is given one with
+//           the same bits per element before it is published.
+//   void publish(const IntSet& replacement)
+//     Pre:  (none)
+//     Post: A copy of replacement has been published as the new
+//           version.
+//
+// VALUE SEMANTICS
+//   Assignment and the copy constructor may NOT be used with
+//   ConcurrentIntSet objects.
+
+#ifndef CONCURRENT_INT_SET_H
+#define CONCURRENT_INT_SET_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "IntSet.h"
+
+class ConcurrentIntSet
+{
+public:
+   static const int MAX_READERS = 256;
+   ConcurrentIntSet();
+   ConcurrentIntSet(const IntSet& initial);
+   ~ConcurrentIntSet();
+   bool contains(int anInt) const;
+   int size() const;
+   IntSet snapshot() const;
+   void update(const IntSet& toAdd, const IntSet& toRemove);
+   void publish(const IntSet& replacement);
+
+private:
+   // one slot per cache line so readers don't bounce each other's lines
+   struct alignas(64) HazardSlot
+   {
+      std::atomic<const IntSet*> pointer;
+   };
+   // current gets a line of its own too: every reader loads it twice
+   // per read, and the line must not be dirtied by slot stores
+   alignas(64) std::atomic<const IntSet*> current;
+   mutable HazardSlot hazards[MAX_READERS];
+   mutable std::mutex writerLock;
+   std::vector<const IntSet*> retired;
+   const IntSet* acquire(int& slot) const;
+   void release(int slot) const;
+   void swapIn(const IntSet* newVersion);
+   ConcurrentIntSet(const ConcurrentIntSet& src);
+   ConcurrentIntSet& operator=(const ConcurrentIntSet& rhs);
+};
+
+#endif
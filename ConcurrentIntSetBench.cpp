@@ -0,0 +1,122 @@
+// FILE: ConcurrentIntSetBench.cpp
+// A non-interactive benchmark of ConcurrentIntSet read throughput.
+//
+// DESCRIPTION:
+// For 1, 2, 4, ... threads (up to twice the hardware threads, at least
+// 8), every thread calls contains in a loop for a fixed time, first on
+// a ConcurrentIntSet and then on an IntSet guarded by one mutex (the
+// baseline a ConcurrentIntSet replaces). A writer thread publishes an
+// update every millisecond in both cases, so readers really do race
+// with writers. The total # of contains calls per second is printed
+// for each case, along with the speedup over the baseline.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 -pthread ConcurrentIntSetBench.cpp
+//       ConcurrentIntSet.cpp IntSet.cpp -o cisb
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ConcurrentIntSet.h"
+using namespace std;
+
+const int SET_SIZE = 4096;
+const int RUN_MILLISECONDS = 300;
+
+// Reader side of the mutex baseline: one lock around every query.
+struct LockedIntSet
+{
+   mutable mutex lock;
+   IntSet set;
+   bool contains(int anInt) const
+   {
+      lock_guard<mutex> guard(lock);
+      return set.contains(anInt);
+   }
+   void update(const IntSet& toAdd, const IntSet& toRemove)
+   {
+      IntSet next = set.unionWith(toAdd).subtract(toRemove);
+      lock_guard<mutex> guard(lock);
+      set = next;
+   }
+};
+
+// Runs readers threads calling target.contains (and one writer calling
+// target.update) for RUN_MILLISECONDS; returns contains calls/second.
+template <class Set>
+double readsPerSecond(Set& target, int readers)
+{
+   atomic<bool> stop(false);
+   atomic<long long> totalReads(0);
+   vector<thread> threads;
+   for (int t = 0; t < readers; ++t)
+      threads.push_back(thread([&, t]()
+      {
+         long long reads = 0;
+         unsigned int probe = 2654435761u * unsigned(t + 1);
+         while (!stop.load(memory_order_relaxed))
+         {
+            for (int i = 0; i < 256; ++i)
+            {
+               probe = probe * 1664525u + 1013904223u;
+               target.contains(int(probe % (2 * SET_SIZE)));
+            }
+            reads += 256;
+         }
+         totalReads += reads;
+      }));
+   thread writer([&]()
+   {
+      for (int k = 0; !stop.load(); ++k)
+      {
+         IntSet toAdd, toRemove;
+         toAdd.add(2 * SET_SIZE + k);
+         toRemove.add(2 * SET_SIZE + k - 1);
+         target.update(toAdd, toRemove);
+         this_thread::sleep_for(chrono::milliseconds(1));
+      }
+   });
+
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   this_thread::sleep_for(chrono::milliseconds(RUN_MILLISECONDS));
+   stop = true;
+   for (size_t t = 0; t < threads.size(); ++t)
+      threads[t].join();
+   writer.join();
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - begin;
+   return double(totalReads.load()) / elapsed.count();
+}
+
+int main()
+{
+   IntSet initial(SET_SIZE);
+   for (int i = 0; i < SET_SIZE; ++i)
+      initial.add(2 * i);
+
+   int hardware = int(thread::hardware_concurrency());
+   int maxReaders = 2 * hardware > 8 ? 2 * hardware : 8;
+   cout << "hardware threads: " << hardware << "\n"
+        << "readers  ConcurrentIntSet (M/s)  mutex IntSet (M/s)  speedup\n";
+   for (int readers = 1; readers <= maxReaders; readers *= 2)
+   {
+      ConcurrentIntSet concurrent(initial);
+      LockedIntSet locked;
+      locked.set = initial;
+      double fast = readsPerSecond(concurrent, readers);
+      double slow = readsPerSecond(locked, readers);
+      cout.setf(ios::fixed);
+      cout.precision(1);
+      cout.width(7);
+      cout << readers;
+      cout.width(26);
+      cout << fast / 1e6;
+      cout.width(20);
+      cout << slow / 1e6;
+      cout.width(9);
+      cout << fast / slow << "x\n";
+   }
+   return 0;
+}
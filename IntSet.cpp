@@ -2,22 +2,19 @@
 //       Implementation file for the IntStore class
 //       (See IntSet.h for documentation.)
 // INVARIANT for the IntSet class:
-// (1) Distinct int values of the IntSet are stored in a 1-D,
-//     dynamic array whose size is stored in member variable
-//     capacity; the member variable data references the array.
-// (2) The distinct int value with earliest membership is stored
-//     in data[0], the distinct int value with the 2nd-earliest
-//     membership is stored in data[1], and so on.
-//     Note: No "prior membership" information is tracked; i.e.,
-//           if an int value that was previously a member (but its
-//           earlier membership ended due to removal) becomes a
-//           member again, the timing of its membership (relative
-//           to other existing members) is the same as if that int
-//           value was never a member before.
-//     Note: Re-introduction of an int value that is already an
-//           existing member (such as through the add operation)
-//           has no effect on the "membership timing" of that int
-//           value.
+// (1) Distinct int values of the IntSet are stored in a 1-D
+//     array whose size is stored in member variable capacity; the
+//     member variable data references the array.
+//     Note: While capacity <= INLINE_CAPACITY the array is the
+//           member array inlineData (so small IntSet's never touch
+//           the heap), otherwise it is a dynamic array. capacity
+//           is never less than INLINE_CAPACITY.
+// (2) The distinct int values are stored in ascending order: the
+//     smallest is stored in data[0], the 2nd-smallest in data[1],
+//     and so on.
+//     Note: This is what lets contains, rank, select and the range
+//           queries binary-search, and the set algebra merge the
+//           two operands in a single linear pass.
 // (4) The # of distinct int values the IntSet currently contains
 //     is stored in the member variable used.
 // (5) Except when the IntSet is empty (used == 0), ALL elements
@@ -40,8 +37,65 @@
 //           the data array and used (if properly initialized and
 //           maintained) should tell which elements of the data
 //           array are actually relevant.
+// (7) The member variable hashSum holds the sum (modulo 2^64) of
+//     mixHash(x) over all elements x of the IntSet. Since addition
+//     is commutative it is maintained in O(1) by add, remove and
+//     reset, and two IntSet's with different hashSum's can't be
+//     equal.
+// (8) If no filter is enabled, filter and filterStorage are 0 and
+//     filterBitsPerElement is 0. Otherwise filter references
+//     filterBlocks blocks of FILTER_BLOCK_WORDS 64-bit words (aligned
+//     to 64 bytes within the dynamic array filterStorage), and for
+//     every element x the filterHashes() bits that filterInsert(x)
+//     sets are set. The filter was sized for filterCapacity elements
+//     and filterStale elements have been removed since it was built
+//     (their bits may still be set, which only costs false
+//     positives). filterStale may exceed filterCapacity / 4 only
+//     until the next refreshFilter (i.e. the next contains).
 //
-// DOCUMENTATION for private member (helper) function:
+// DOCUMENTATION for private member (helper) functions:
+//   static unsigned long long mixHash(int anInt)
+//     Pre:  (none)
+//     Post: The 64-bit hash of anInt that hashSum sums is returned.
+//   void rehash()
+//     Pre:  data[0] through data[used - 1] hold the elements.
+//     Post: hashSum has been recomputed from scratch (used after
+//           the elements were written in bulk).
+//   int filterHashes() const
+//     Pre:  A filter is enabled.
+//     Post: The # of bits set per element (k) is returned.
+//   bool filterMayContain(int anInt) const
+//     Pre:  A filter is enabled.
+//     Post: false is returned only if anInt is surely not an element.
+//   void filterInsert(int anInt) const
+//     Pre:  A filter is enabled.
+//     Post: The bits of anInt have been set in its block.
+//   void allocateFilter(int blocks) const
+//     Pre:  blocks >= 1
+//     Post: filter references blocks zeroed, 64-byte aligned blocks
+//           (the previous filter, if any, has been freed).
+//   void rebuildFilter() const
+//     Pre:  filterBitsPerElement >= 1
+//     Post: The filter has been resized for the current # of
+//           elements (with room to grow) and refilled from data;
+//           filterStale is 0.
+//   void refreshFilter() const
+//     Pre:  (none)
+//     Post: If a filter is enabled and more than filterCapacity / 4
+//           elements have been removed since it was built, it has
+//           been rebuilt.
+//   void noteRemovals(int removed)
+//     Pre:  removed elements have just been removed.
+//     Post: If a filter is enabled, removed has been added to
+//           filterStale (the rebuild, if one is due, is left to the
+//           next refreshFilter).
+//   IntSet parallelSetOperation(const IntSet& otherIntSet,
+//                               SetOperation operation,
+//                               int threadCount) const
+//     Pre:  (none)
+//     Post: The union, intersection or difference (per operation) of
+//           the invoking IntSet and otherIntSet is returned, computed
+//           as described for parallelUnionWith in IntSet.h.
 //   void resize(int new_capacity)
 //     Pre:  (none)
 //           Note: Recall that one of the things a constructor
@@ -51,7 +105,7 @@
 //                 be used within constructors unless it is at
 //                 a point where the class invariant has already
 //                 been made to hold true.
-//     Post: The capacity (size of the dynamic array) of the
+//     Post: The capacity (size of the array) of the
 //           invoking IntSet is changed to new_capacity...
 //           ...EXCEPT when new_capacity would not allow the
 //           invoking IntSet to preserve current contents (i.e.,
@@ -61,71 +115,419 @@
 //           is set to "the minimum that is needed" (which is the
 //           same as "exactly what is needed") to preserve current
 //           contents...
-//           ...BUT if "exactly what is needed" is 0 (i.e. existing
-//           collection is empty) then the capacity should be
-//           further adjusted to 1 or DEFAULT_CAPACITY (since we
-//           don't want to request dynamic arrays of size 0).
+//           ...BUT if "exactly what is needed" is less than
+//           INLINE_CAPACITY then the capacity is adjusted up to
+//           INLINE_CAPACITY and the contents are kept in
+//           inlineData (releasing any dynamic array).
 //           The collection represented by the invoking IntSet
 //           remains unchanged.
 //           If reallocation of dynamic array is unsuccessful, an
 //           error message to the effect is displayed and the
 //           program unconditionally terminated.
+//
+// DOCUMENTATION for the (file-local) serialization helpers:
+//   The binary format is documented with serialize() in IntSet.h.
+//   Elements are ordered as unsigned 32-bit keys obtained by
+//   flipping the sign bit (so that INT_MIN maps to 0 and INT_MAX
+//   to 0xFFFFFFFF); consecutive keys of a sorted set therefore
+//   always differ by at least 1 and the deltas fit in 32 bits.
 
 #include "IntSet.h"
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 using namespace std;
 
-void IntSet::resize(int new_capacity)
+static const unsigned char SERIAL_MAGIC[4] = { 'I', 'S', 'B', '1' };
+static const unsigned char SERIAL_MAGIC_RAW[4] = { 'I', 'S', 'R', '1' };
+static const size_t SERIAL_HEADER_SIZE = 16;
+static const size_t SERIAL_MAX_VARINT = 5;
+static const size_t SERIAL_READ_CHUNK = 1 << 20;
+
+// Output iterator that only counts what a merge would write; used
+// to size each slice of a parallel result before filling it.
+struct CountingIterator
+{
+   size_t count;
+   CountingIterator() : count(0) { }
+   CountingIterator& operator*() { return *this; }
+   CountingIterator& operator=(int) { ++count; return *this; }
+   CountingIterator& operator++() { return *this; }
+   CountingIterator& operator++(int) { return *this; }
+};
+
+// operation is an IntSet::SetOperation (UNION_OP, INTERSECT_OP or
+// SUBTRACT_OP, in that order)
+template <class OutputIterator>
+static OutputIterator mergeRanges(int operation, const int* a, const int* aEnd,
+                                  const int* b, const int* bEnd,
+                                  OutputIterator out)
+{
+   switch (operation)
+   {
+   case 0:  return set_union(a, aEnd, b, bEnd, out);
+   case 1:  return set_intersection(a, aEnd, b, bEnd, out);
+   default: return set_difference(a, aEnd, b, bEnd, out);
+   }
+}
+
+// Returns the first position in [first, last) whose value is >= anInt,
+// probing 1, 2, 4, ... elements ahead before the binary search, so
+// short skips (the common case when intersecting) stay cheap.
+static const int* gallop(const int* first, const int* last, int anInt)
+{
+   size_t step = 1;
+   const int* low = first;
+   while (size_t(last - low) > step && low[step] < anInt)
+   {
+      low += step;
+      step *= 2;
+   }
+   const int* high = size_t(last - low) > step ? low + step + 1 : last;
+   return lower_bound(low, high, anInt);
+}
+
+static bool smallerIntSet(const IntSet* a, const IntSet* b)
 {
-   if (new_capacity<used){
-    new_capacity=used;
+   return a->size() < b->size();
+}
+
+static int resolveThreadCount(int threadCount)
+{
+   if (threadCount <= 0)
+      threadCount = int(thread::hardware_concurrency());
+   return threadCount < 1 ? 1 : threadCount;
+}
+
+// The parallel operations hand their slices to one process-wide pool
+// of worker threads, started the first time they are needed and kept
+// until exit, so a call costs a wake-up per worker rather than a
+// thread creation. The calling thread runs slices too. A call made
+// while another call is using the pool runs all of its slices on the
+// calling thread (so concurrent callers never wait on each other).
+class SlicePool
+{
+public:
+   static SlicePool& instance()
+   {
+      static SlicePool pool;
+      return pool;
+   }
+
+   // Runs task(0) through task(parts - 1), each exactly once, and
+   // returns when all of them have finished.
+   void run(int parts, const function<void(int)>& task)
+   {
+      unique_lock<mutex> busy(callLock, try_to_lock);
+      if (parts <= 1 || !busy.owns_lock())
+      {
+         for (int p = 0; p < parts; ++p)
+            task(p);
+         return;
+      }
+      unique_lock<mutex> guard(lock);
+      while (int(workers.size()) < parts - 1)
+         workers.push_back(thread(&SlicePool::work, this, generation));
+      job = &task;
+      jobParts = parts;
+      nextPart = 0;
+      unfinished = parts;
+      ++generation;
+      wake.notify_all();
+      runSlices(guard);
+      while (unfinished > 0)
+         finished.wait(guard);
+      job = 0;
+   }
+
+private:
+   mutex callLock;   // held by the one call using the workers
+   mutex lock;       // guards all of the members below
+   condition_variable wake;
+   condition_variable finished;
+   vector<thread> workers;
+   const function<void(int)>* job;
+   int jobParts;
+   int nextPart;     // the next slice no thread has claimed yet
+   int unfinished;   // slices not finished yet
+   unsigned long long generation;   // # of calls handed to the workers
+   bool stopping;
+
+   SlicePool() : job(0), jobParts(0), nextPart(0), unfinished(0),
+                 generation(0), stopping(false) { }
+
+   ~SlicePool()
+   {
+      {
+         lock_guard<mutex> guard(lock);
+         stopping = true;
+      }
+      wake.notify_all();
+      for (size_t i = 0; i < workers.size(); ++i)
+         workers[i].join();
    }
-   if (new_capacity<1){
-    new_capacity=1;
+
+   // Claims and runs slices of the current call until none are left;
+   // guard holds lock on entry and on return.
+   void runSlices(unique_lock<mutex>& guard)
+   {
+      while (nextPart < jobParts)
+      {
+         int p = nextPart++;
+         guard.unlock();
+         (*job)(p);
+         guard.lock();
+         if (--unfinished == 0)
+            finished.notify_all();
+      }
    }
-   capacity=new_capacity;
-   int* newData= new int[capacity];
-   for(int i; i<used; ++i){
-    newData[i]=data[i];
+
+   void work(unsigned long long seen)
+   {
+      unique_lock<mutex> guard(lock);
+      for (;;)
+      {
+         while (!stopping && generation == seen)
+            wake.wait(guard);
+         if (stopping)
+            return;
+         seen = generation;
+         runSlices(guard);
+      }
    }
-   delete[]data;
-   data=newData;
+};
+
+static unsigned int toKey(int anInt)
+{
+   return static_cast<unsigned int>(anInt) ^ 0x80000000u;
+}
+
+static int fromKey(unsigned int key)
+{
+   key ^= 0x80000000u;
+   if (key <= 0x7FFFFFFFu)
+      return static_cast<int>(key);
+   return -static_cast<int>(~key) - 1;
+}
+
+static void putUint32(unsigned char* dest, unsigned int value)
+{
+   dest[0] = static_cast<unsigned char>(value);
+   dest[1] = static_cast<unsigned char>(value >> 8);
+   dest[2] = static_cast<unsigned char>(value >> 16);
+   dest[3] = static_cast<unsigned char>(value >> 24);
+}
+
+static unsigned int getUint32(const unsigned char* src)
+{
+   return static_cast<unsigned int>(src[0])
+          | (static_cast<unsigned int>(src[1]) << 8)
+          | (static_cast<unsigned int>(src[2]) << 16)
+          | (static_cast<unsigned int>(src[3]) << 24);
 }
 
-IntSet::IntSet(int initial_capacity): capacity(initial_capacity), used(0)
+static unsigned int adler32(const unsigned char* bytes, size_t length)
 {
-   if (initial_capacity<1){
-    capacity=DEFAULT_CAPACITY;
+   const unsigned int MOD_ADLER = 65521;
+   unsigned int a = 1, b = 0;
+   while (length > 0)
+   {
+      // 5552 is the largest block for which b cannot overflow
+      size_t block = length < 5552 ? length : 5552;
+      length -= block;
+      while (block-- > 0)
+      {
+         a += *bytes++;
+         b += a;
+      }
+      a %= MOD_ADLER;
+      b %= MOD_ADLER;
    }
-   data=new int[initial_capacity];
+   return (b << 16) | a;
+}
+
+// splitmix64 finalizer: spreads every input bit over all 64 output
+// bits, so sums of mixed values rarely collide for unequal sets
+unsigned long long IntSet::mixHash(int anInt)
+{
+   unsigned long long z = static_cast<unsigned int>(anInt)
+                          + 0x9E3779B97F4A7C15ull;
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+   return z ^ (z >> 31);
+}
+
+void IntSet::rehash()
+{
+   hashSum = 0;
+   for (int i = 0; i < used; ++i)
+      hashSum += mixHash(data[i]);
+}
+
+int IntSet::filterHashes() const
+{
+   // k = bits per element * ln 2 minimizes the false positive rate
+   int k = int(filterBitsPerElement * 0.693 + 0.5);
+   return k < 1 ? 1 : (k > 8 ? 8 : k);
 }
 
-IntSet::IntSet(const IntSet& src):capacity(src.capacity),used(src.used)
+bool IntSet::filterMayContain(int anInt) const
 {
-   data = new int [capacity];
-   for (int i=0; i < used; ++i){
-    data[i]=src.data[i];
+   unsigned long long h = mixHash(anInt);
+   const unsigned long long* block = filter + FILTER_BLOCK_WORDS
+      * size_t(((h >> 32) * (unsigned long long)filterBlocks) >> 32);
+   for (int j = filterHashes(); j > 0; --j)
+   {
+      // each LCG step yields a fresh 9-bit position within the block
+      h = h * 6364136223846793005ull + 1442695040888963407ull;
+      unsigned int bit = unsigned(h >> 55);
+      if (((block[bit >> 6] >> (bit & 63)) & 1) == 0)
+         return false;
+   }
+   return true;
+}
+
+void IntSet::filterInsert(int anInt) const
+{
+   unsigned long long h = mixHash(anInt);
+   unsigned long long* block = filter + FILTER_BLOCK_WORDS
+      * size_t(((h >> 32) * (unsigned long long)filterBlocks) >> 32);
+   for (int j = filterHashes(); j > 0; --j)
+   {
+      h = h * 6364136223846793005ull + 1442695040888963407ull;
+      unsigned int bit = unsigned(h >> 55);
+      block[bit >> 6] |= 1ull << (bit & 63);
+   }
+}
+
+void IntSet::allocateFilter(int blocks) const
+{
+   delete [] filterStorage;
+   // over-allocate by one block so filter can start on a cache line
+   filterStorage = new unsigned long long [(blocks + 1) * FILTER_BLOCK_WORDS];
+   size_t misalignment = reinterpret_cast<size_t>(filterStorage) % 64;
+   filter = filterStorage
+            + (misalignment == 0 ? 0 : (64 - misalignment) / 8);
+   filterBlocks = blocks;
+   fill(filter, filter + blocks * FILTER_BLOCK_WORDS, 0ull);
+}
+
+void IntSet::rebuildFilter() const
+{
+   filterCapacity = used + used / 2;
+   if (filterCapacity < 64)
+      filterCapacity = 64;
+   int bitsPerBlock = FILTER_BLOCK_WORDS * 64;
+   int blocks = int((double(filterCapacity) * filterBitsPerElement
+                     + bitsPerBlock - 1) / bitsPerBlock);
+   allocateFilter(blocks);
+   for (int i = 0; i < used; ++i)
+      filterInsert(data[i]);
+   filterStale = 0;
+}
+
+void IntSet::noteRemovals(int removed)
+{
+   if (filter == 0)
+      return;
+   filterStale += removed;
+}
+
+void IntSet::refreshFilter() const
+{
+   if (filter != 0 && filterStale > filterCapacity / 4)
+      rebuildFilter();
+}
+
+void IntSet::resize(int new_capacity)
+{
+   if (new_capacity < used)
+      new_capacity = used;
+   if (new_capacity < INLINE_CAPACITY)
+      new_capacity = INLINE_CAPACITY;
+   if (new_capacity == capacity)
+      return;
+   int* newData = (new_capacity == INLINE_CAPACITY)
+                  ? inlineData : new int [new_capacity];
+   if (newData != data)
+   {
+      copy(data, data + used, newData);
+      if (data != inlineData)
+         delete [] data;
    }
+   data = newData;
+   capacity = new_capacity;
 }
 
+IntSet::basic_set(int initial_capacity)
+   : data(inlineData), capacity(INLINE_CAPACITY), used(0), hashSum(0),
+     filterStorage(0), filter(0), filterBlocks(0), filterBitsPerElement(0),
+     filterCapacity(0), filterStale(0)
+{
+   if (initial_capacity > INLINE_CAPACITY)
+   {
+      data = new int [initial_capacity];
+      capacity = initial_capacity;
+   }
+}
 
-IntSet::~IntSet()
+IntSet::basic_set(const IntSet& src)
+   : data(inlineData), capacity(INLINE_CAPACITY), used(src.used),
+     hashSum(src.hashSum), filterStorage(0), filter(0), filterBlocks(0),
+     filterBitsPerElement(src.filterBitsPerElement),
+     filterCapacity(src.filterCapacity), filterStale(src.filterStale)
 {
-   delete [] data;
+   if (used > INLINE_CAPACITY)
+   {
+      data = new int [src.capacity];
+      capacity = src.capacity;
+   }
+   copy(src.data, src.data + used, data);
+   if (src.filter != 0)
+   {
+      allocateFilter(src.filterBlocks);
+      copy(src.filter, src.filter + filterBlocks * FILTER_BLOCK_WORDS, filter);
+   }
+}
+
+
+IntSet::~basic_set()
+{
+   if (data != inlineData)
+      delete [] data;
+   delete [] filterStorage;
 }
 
 IntSet& IntSet::operator=(const IntSet& rhs)
 {
-   if (this != &rhs){
-    int* newData=new int [rhs.capacity];
-    for (int i; i < rhs.used; ++i){
-        newData[i]=rhs.data[i];
-        }
-    delete [] data;
-    data=newData;
-    capacity=rhs.capacity;
-    used=rhs.used;
+   if (this != &rhs)
+   {
+      if (rhs.used > capacity)
+      {
+         used = 0;   // nothing to preserve across the reallocation
+         resize(rhs.capacity);
+      }
+      copy(rhs.data, rhs.data + rhs.used, data);
+      used = rhs.used;
+      hashSum = rhs.hashSum;
+      if (rhs.filter == 0)
+         disableFilter();
+      else
+      {
+         if (filterBlocks != rhs.filterBlocks)
+            allocateFilter(rhs.filterBlocks);
+         copy(rhs.filter, rhs.filter + filterBlocks * FILTER_BLOCK_WORDS,
+              filter);
+      }
+      filterBitsPerElement = rhs.filterBitsPerElement;
+      filterCapacity = rhs.filterCapacity;
+      filterStale = rhs.filterStale;
    }
    return *this;
 }
@@ -145,26 +547,89 @@ bool IntSet::isEmpty() const
 
 bool IntSet::contains(int anInt) const
 {
-   for(int i = 0; i < used; i++)
-   {
-      if(data[i] == anInt)
-      {
-         return true;
-      }
-   }
-   return false;
+   refreshFilter();
+   if (filter != 0 && !filterMayContain(anInt))
+      return false;
+   return binary_search(data, data + used, anInt);
 }
 
 bool IntSet::isSubsetOf(const IntSet& otherIntSet) const
 {
-   for(int i = 0; i < used; i++)
-   {
-      if(!otherIntSet.contains(data[i]))
-      {
-         return false;
-      }
-   }
-   return true;
+   return used <= otherIntSet.used
+          && includes(otherIntSet.data, otherIntSet.data + otherIntSet.used,
+                      data, data + used);
+}
+
+int IntSet::rank(int anInt) const
+{
+   return int(lower_bound(data, data + used, anInt) - data);
+}
+
+int IntSet::select(int k) const
+{
+   assert(k >= 0 && k < used);
+   return data[k];
+}
+
+int IntSet::countInRange(int lo, int hi) const
+{
+   if (lo > hi)
+      return 0;
+   return int(upper_bound(data, data + used, hi)
+              - lower_bound(data, data + used, lo));
+}
+
+unsigned long long IntSet::fingerprint() const
+{
+   return hashSum;
+}
+
+bool IntSet::hasFilter() const
+{
+   return filter != 0;
+}
+
+double IntSet::filterFalsePositiveRate() const
+{
+   if (filter == 0)
+      return 1.0;
+   size_t words = size_t(filterBlocks) * FILTER_BLOCK_WORDS;
+   size_t setBits = 0;
+   for (size_t i = 0; i < words; ++i)
+      for (unsigned long long w = filter[i]; w != 0; w &= w - 1)
+         ++setBits;
+   // a miss gets through when all k of its bits happen to be set
+   double fill = double(setBits) / double(words * 64);
+   double rate = 1.0;
+   for (int j = filterHashes(); j > 0; --j)
+      rate *= fill;
+   return rate;
+}
+
+size_t IntSet::filterMemory() const
+{
+   return filter == 0 ? 0 : size_t(filterBlocks) * FILTER_BLOCK_WORDS
+                                * sizeof(unsigned long long);
+}
+
+IntSet::const_iterator IntSet::begin() const
+{
+   return data;
+}
+
+IntSet::const_iterator IntSet::end() const
+{
+   return data + used;
+}
+
+IntSet::const_iterator IntSet::lowerBound(int anInt) const
+{
+   return lower_bound(data, data + used, anInt);
+}
+
+IntSet::const_iterator IntSet::upperBound(int anInt) const
+{
+   return upper_bound(data, data + used, anInt);
 }
 
 void IntSet::DumpData(ostream& out) const
@@ -177,102 +642,494 @@ void IntSet::DumpData(ostream& out) const
    }
 }
 
-IntSet IntSet::unionWith(const IntSet& otherIntSet) const
+void IntSet::serialize(ostream& out, bool compact) const
 {
-  //  for (int i=0; i <otherIntSet.used; ++i){
-   //     add(otherIntSet.data[i]);
-  //  }
-     IntSet a;
-
-      for(int i = 0; i < used; i++)
-      {
-         a.add(data[i]);
-      }
-
-      for(int i = 0; i < otherIntSet.size(); i++)
+   unsigned char* buffer =
+      new unsigned char [SERIAL_HEADER_SIZE + SERIAL_MAX_VARINT * used];
+   unsigned char* payload = buffer + SERIAL_HEADER_SIZE;
+   size_t length = 0;
+   if (compact)
+   {
+      unsigned int previous = 0;
+      for (int i = 0; i < used; ++i)
       {
+         unsigned int delta = toKey(data[i]) - previous;
+         previous = toKey(data[i]);
+         while (delta >= 0x80)
          {
-            a.add(otherIntSet.data[i]);
+            payload[length++] = static_cast<unsigned char>(delta | 0x80);
+            delta >>= 7;
          }
+         payload[length++] = static_cast<unsigned char>(delta);
       }
-      return a;
+   }
+   else
+   {
+      for (int i = 0; i < used; ++i, length += 4)
+         putUint32(payload + length, static_cast<unsigned int>(data[i]));
+   }
+
+   copy(compact ? SERIAL_MAGIC : SERIAL_MAGIC_RAW,
+        (compact ? SERIAL_MAGIC : SERIAL_MAGIC_RAW) + 4, buffer);
+   putUint32(buffer + 4, static_cast<unsigned int>(used));
+   putUint32(buffer + 8, static_cast<unsigned int>(length));
+   putUint32(buffer + 12, adler32(payload, length));
+   out.write(reinterpret_cast<const char*>(buffer),
+             SERIAL_HEADER_SIZE + length);
+   delete [] buffer;
+}
+
+IntSet IntSet::unionWith(const IntSet& otherIntSet) const
+{
+   // when both operands are small the union may still fit inline, so
+   // it is merged into scratch first and the result sized from that
+   int scratch[2 * INLINE_CAPACITY];
+   bool small = used <= INLINE_CAPACITY
+                && otherIntSet.used <= INLINE_CAPACITY;
+   int count = small
+               ? int(set_union(data, data + used, otherIntSet.data,
+                               otherIntSet.data + otherIntSet.used, scratch)
+                     - scratch)
+               : used + otherIntSet.used;
+   IntSet a(count);
+
+   if (small)
+      a.used = int(copy(scratch, scratch + count, a.data) - a.data);
+   else
+      a.used = int(set_union(data, data + used, otherIntSet.data,
+                             otherIntSet.data + otherIntSet.used, a.data)
+                   - a.data);
+   a.rehash();
+   return a;
 }
 
 IntSet IntSet::intersect(const IntSet& otherIntSet) const
 {
-   IntSet b;
+   IntSet b(used < otherIntSet.used ? used : otherIntSet.used);
+
+   b.used = int(set_intersection(data, data + used, otherIntSet.data,
+                                 otherIntSet.data + otherIntSet.used, b.data)
+                - b.data);
+   b.rehash();
+   return b;
+}
+
+IntSet IntSet::subtract(const IntSet& otherIntSet) const
+{
+   IntSet c(used);
+
+   c.used = int(set_difference(data, data + used, otherIntSet.data,
+                               otherIntSet.data + otherIntSet.used, c.data)
+                - c.data);
+   c.rehash();
+   return c;
+}
+
+IntSet IntSet::parallelSetOperation(const IntSet& otherIntSet,
+                                    SetOperation operation,
+                                    int threadCount) const
+{
+   const IntSet& larger = used >= otherIntSet.used ? *this : otherIntSet;
+   int parts = resolveThreadCount(threadCount);
+   if (parts > larger.used / 1024)
+      parts = larger.used / 1024 > 0 ? larger.used / 1024 : 1;
+   // one slice would only add the counting pass to the plain merge
+   if (parts == 1)
+      return operation == UNION_OP ? unionWith(otherIntSet)
+         : operation == INTERSECT_OP ? intersect(otherIntSet)
+         : subtract(otherIntSet);
+
+   // slice p covers values in [splitter p, splitter p + 1) of both
+   vector<const int*> aBound(parts + 1), bBound(parts + 1);
+   aBound[0] = data;
+   bBound[0] = otherIntSet.data;
+   aBound[parts] = data + used;
+   bBound[parts] = otherIntSet.data + otherIntSet.used;
+   for (int p = 1; p < parts; ++p)
+   {
+      int splitter = larger.data[size_t(larger.used) * p / parts];
+      aBound[p] = lower_bound(data, data + used, splitter);
+      bBound[p] = lower_bound(otherIntSet.data,
+                              otherIntSet.data + otherIntSet.used, splitter);
+   }
+
+   vector<size_t> offset(parts + 1, 0);
+   SlicePool::instance().run(parts, [&](int p)
+   {
+      offset[p + 1] = mergeRanges(operation, aBound[p], aBound[p + 1],
+                                  bBound[p], bBound[p + 1],
+                                  CountingIterator()).count;
+   });
+   for (int p = 0; p < parts; ++p)
+      offset[p + 1] += offset[p];
+
+   IntSet result(int(offset[parts]));
+   vector<unsigned long long> sliceHash(parts, 0);
+   SlicePool::instance().run(parts, [&](int p)
+   {
+      int* out = result.data + offset[p];
+      int* outEnd = mergeRanges(operation, aBound[p], aBound[p + 1],
+                                bBound[p], bBound[p + 1], out);
+      for (; out != outEnd; ++out)
+         sliceHash[p] += mixHash(*out);
+   });
+
+   result.used = int(offset[parts]);
+   for (int p = 0; p < parts; ++p)
+      result.hashSum += sliceHash[p];
+   return result;
+}
+
+IntSet IntSet::parallelUnionWith(const IntSet& otherIntSet,
+                                 int threadCount) const
+{
+   if (used + otherIntSet.used < PARALLEL_THRESHOLD)
+      return unionWith(otherIntSet);
+   return parallelSetOperation(otherIntSet, UNION_OP, threadCount);
+}
 
-   for(int i = 0; i < used; i++)
+IntSet IntSet::parallelIntersect(const IntSet& otherIntSet,
+                                 int threadCount) const
+{
+   if (used + otherIntSet.used < PARALLEL_THRESHOLD)
+      return intersect(otherIntSet);
+   return parallelSetOperation(otherIntSet, INTERSECT_OP, threadCount);
+}
+
+IntSet IntSet::parallelSubtract(const IntSet& otherIntSet,
+                                int threadCount) const
+{
+   if (used + otherIntSet.used < PARALLEL_THRESHOLD)
+      return subtract(otherIntSet);
+   return parallelSetOperation(otherIntSet, SUBTRACT_OP, threadCount);
+}
+
+bool IntSet::parallelIsSubsetOf(const IntSet& otherIntSet,
+                                int threadCount) const
+{
+   if (used > otherIntSet.used)
+      return false;
+   if (used + otherIntSet.used < PARALLEL_THRESHOLD)
+      return isSubsetOf(otherIntSet);
+
+   int parts = resolveThreadCount(threadCount);
+   if (parts > used / 1024)
+      parts = used / 1024 > 0 ? used / 1024 : 1;
+   atomic<bool> subset(true);
+   SlicePool::instance().run(parts, [&](int p)
    {
-      if(otherIntSet.contains(data[i]))
+      const int* first = data + size_t(used) * p / parts;
+      const int* last = data + size_t(used) * (p + 1) / parts;
+      if (first == last || !subset.load())
+         return;
+      const int* otherFirst = otherIntSet.lowerBound(*first);
+      const int* otherLast = upper_bound(otherFirst, otherIntSet.end(),
+                                         *(last - 1));
+      if (!includes(otherFirst, otherLast, first, last))
+         subset.store(false);
+   });
+   return subset.load();
+}
+
+IntSet IntSet::intersectAll(const IntSet* const sets[], int count)
+{
+   if (count <= 0)
+      return IntSet();
+   vector<const IntSet*> order(sets, sets + count);
+   sort(order.begin(), order.end(), smallerIntSet);
+   vector<const int*> cursor(count);
+   for (int j = 0; j < count; ++j)
+      cursor[j] = order[j]->data;
+
+   const IntSet& smallest = *order[0];
+   const int* smallestEnd = smallest.data + smallest.used;
+   IntSet result(smallest.used);
+   const int* candidate = smallest.data;
+   while (candidate != smallestEnd)
+   {
+      int value = *candidate;
+      bool inAll = true;
+      for (int j = 1; j < count && inAll; ++j)
       {
-         b.add(data[i]);
+         const int* otherEnd = order[j]->data + order[j]->used;
+         cursor[j] = gallop(cursor[j], otherEnd, value);
+         if (cursor[j] == otherEnd)
+            return result;   // no later candidate can be in set j
+         if (*cursor[j] != value)
+         {
+            // skip straight to the first candidate that might match
+            inAll = false;
+            candidate = gallop(candidate, smallestEnd, *cursor[j]);
+         }
+      }
+      if (inAll)
+      {
+         result.data[result.used++] = value;
+         result.hashSum += mixHash(value);
+         ++candidate;
       }
    }
+   return result;
+}
 
-   return b;
+IntSet IntSet::unionAll(const IntSet* const sets[], int count)
+{
+   if (count <= 0)
+      return IntSet();
 
+   // fold the inputs in smallest first, so the running union stays
+   // small for as long as possible; it alternates between two scratch
+   // buffers that are reused (not reallocated) from step to step, and
+   // the last step merges straight into the result
+   vector<const IntSet*> order(sets, sets + count);
+   sort(order.begin(), order.end(), smallerIntSet);
+   vector<int> scratch[2];
+   const int* soFar = order[0]->begin();
+   const int* soFarEnd = order[0]->end();
+   for (int j = 1; j < count - 1; ++j)
+   {
+      vector<int>& buffer = scratch[j % 2];
+      size_t bound = size_t(soFarEnd - soFar) + order[j]->used;
+      if (buffer.size() < bound)
+         buffer.resize(bound);
+      soFarEnd = set_union(soFar, soFarEnd, order[j]->begin(), order[j]->end(),
+                           buffer.data());
+      soFar = buffer.data();
+   }
+   const IntSet& last = *order[count - 1];
+   IntSet result(int(soFarEnd - soFar) + (count > 1 ? last.used : 0));
+   if (count > 1)
+      result.used = int(set_union(soFar, soFarEnd, last.begin(), last.end(),
+                                  result.data) - result.data);
+   else
+      result.used = int(copy(soFar, soFarEnd, result.data) - result.data);
+   result.rehash();
+   return result;
 }
 
-IntSet IntSet::subtract(const IntSet& otherIntSet) const
+bool IntSet::deserialize(istream& in)
 {
-   IntSet c;
+   unsigned char header[SERIAL_HEADER_SIZE];
+   if (!in.read(reinterpret_cast<char*>(header), SERIAL_HEADER_SIZE))
+      return false;
+   unsigned int count = getUint32(header + 4);
+   unsigned int length = getUint32(header + 8);
+   if (equal(SERIAL_MAGIC, SERIAL_MAGIC + 4, header))
+   {
+      if (length < count || length / SERIAL_MAX_VARINT > count)
+         return false;
+   }
+   else if (equal(SERIAL_MAGIC_RAW, SERIAL_MAGIC_RAW + 4, header))
+   {
+      if (length / 4 != count || length % 4 != 0)
+         return false;
+   }
+   else
+      return false;
 
-   for(int i = 0; i < used; i++)
+   // length comes from the stream and may be up to 4 GB, so the
+   // buffer only grows (by at most SERIAL_READ_CHUNK) as the bytes
+   // actually arrive; a forged header on a short stream costs no more
+   // memory than the stream holds
+   vector<unsigned char> buffer(header, header + SERIAL_HEADER_SIZE);
+   size_t remaining = length;
+   while (remaining > 0)
    {
-      c.add(data[i]);
+      size_t chunk = min(remaining, SERIAL_READ_CHUNK);
+      size_t received = buffer.size();
+      buffer.resize(received + chunk);
+      if (!in.read(reinterpret_cast<char*>(&buffer[received]), chunk))
+         return false;
+      remaining -= chunk;
    }
+   return deserialize(&buffer[0], buffer.size());
+}
+
+bool IntSet::deserialize(const unsigned char* buffer, size_t length)
+{
+   if (buffer == 0 || length < SERIAL_HEADER_SIZE)
+      return false;
+   bool compact = equal(SERIAL_MAGIC, SERIAL_MAGIC + 4, buffer);
+   if (!compact && !equal(SERIAL_MAGIC_RAW, SERIAL_MAGIC_RAW + 4, buffer))
+      return false;
+   size_t count = getUint32(buffer + 4);
+   size_t payloadLength = getUint32(buffer + 8);
+   const unsigned char* payload = buffer + SERIAL_HEADER_SIZE;
+   // every element takes at least 1 byte (4 in the raw format), so a
+   // count the payload can't hold is rejected before allocating for it
+   if (count > 0x7FFFFFFFu || payloadLength > length - SERIAL_HEADER_SIZE
+       || (compact && payloadLength < count)
+       || (!compact && payloadLength != 4 * count)
+       || adler32(payload, payloadLength) != getUint32(buffer + 12))
+      return false;
 
-   for(int i = 0; i < otherIntSet.size(); i++)
+   // small sets are decoded into scratch and end up in inlineData
+   int scratch[INLINE_CAPACITY];
+   int* newData = (count <= size_t(INLINE_CAPACITY))
+                  ? scratch : new int [count];
+   bool valid = true;
+   size_t pos = 0;
+   unsigned long long key = 0;
+   for (size_t i = 0; valid && i < count; ++i)
    {
-      if(c.contains(otherIntSet.data[i]))
+      unsigned long long delta = 0;
+      if (compact)
       {
-         c.remove(otherIntSet.data[i]);
+         int shift = 0;
+         unsigned char byte = 0x80;
+         while (valid && (byte & 0x80))
+         {
+            valid = pos < payloadLength && shift <= 28;
+            if (valid)
+            {
+               byte = payload[pos++];
+               delta |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+               shift += 7;
+            }
+         }
+      }
+      else
+      {
+         unsigned int next = toKey(static_cast<int>(getUint32(payload + pos)));
+         pos += 4;
+         delta = (i > 0 && next <= key) ? 0 : next - key;
       }
+      key += delta;
+      // keys must be strictly increasing (distinct) and fit in 32 bits
+      valid = valid && (i == 0 || delta > 0) && key <= 0xFFFFFFFFull;
+      if (valid)
+         newData[i] = fromKey(static_cast<unsigned int>(key));
+   }
+   if (!valid || pos != payloadLength)
+   {
+      if (newData != scratch)
+         delete [] newData;
+      return false;
    }
 
-   return c;
+   if (data != inlineData)
+      delete [] data;
+   used = static_cast<int>(count);
+   if (newData == scratch)
+   {
+      copy(scratch, scratch + used, inlineData);
+      data = inlineData;
+      capacity = INLINE_CAPACITY;
+   }
+   else
+   {
+      data = newData;
+      capacity = used;
+   }
+   rehash();
+   if (filter != 0)
+      rebuildFilter();
+   return true;
+}
 
+void IntSet::enableFilter(int bitsPerElement)
+{
+   assert(bitsPerElement >= 1);
+   filterBitsPerElement = bitsPerElement;
+   rebuildFilter();
+}
+
+void IntSet::disableFilter()
+{
+   delete [] filterStorage;
+   filterStorage = 0;
+   filter = 0;
+   filterBlocks = 0;
+   filterBitsPerElement = 0;
+   filterCapacity = 0;
+   filterStale = 0;
 }
 
 void IntSet::reset()
 {
    used=0;
+   hashSum = 0;
+   if (filter != 0)
+   {
+      fill(filter, filter + filterBlocks * FILTER_BLOCK_WORDS, 0ull);
+      filterStale = 0;
+   }
 }
 
 bool IntSet::add(int anInt)
 {
-   if (contains(anInt)==0){
-    if (used>capacity){
-        resize(int(1.5*capacity)+1);
-        }
-    data[used]=anInt;
-    used++;
-    return true;
+   int pos = rank(anInt);
+   if (pos < used && data[pos] == anInt)
+      return false;
+   if (used == capacity)
+      resize(int(1.5*capacity)+1);
+   copy_backward(data + pos, data + used, data + used + 1);
+   data[pos] = anInt;
+   ++used;
+   hashSum += mixHash(anInt);
+   if (filter != 0)
+   {
+      if (used > filterCapacity)
+         rebuildFilter();
+      else
+         filterInsert(anInt);
    }
-   return false;
+   return true;
 }
 
 bool IntSet::remove(int anInt)
 {
-   if(contains(anInt)){
-      for(int i = 0; i < size(); i++){
-         if(data[i] == anInt){
-            for(int j = i; j < size() - 1; j++){
-               data[j] = data[j+1];
-            }
-            used--;
-            return true;
-         }
-      }
+   int pos = rank(anInt);
+   if (pos == used || data[pos] != anInt)
+      return false;
+   copy(data + pos + 1, data + used, data + pos);
+   --used;
+   hashSum -= mixHash(anInt);
+   noteRemovals(1);
+   return true;
+}
+
+int IntSet::removeAll(const IntSet& otherIntSet)
+{
+   int kept = 0, j = 0;
+   for (int i = 0; i < used; ++i)
+   {
+      while (j < otherIntSet.used && otherIntSet.data[j] < data[i])
+         ++j;
+      if (j < otherIntSet.used && otherIntSet.data[j] == data[i])
+         hashSum -= mixHash(data[i]);
+      else
+         data[kept++] = data[i];
    }
-   return false;
+   int removed = used - kept;
+   used = kept;
+   noteRemovals(removed);
+   return removed;
+}
+
+int IntSet::removeRange(int first, int last)
+{
+   if (first > last)
+      return 0;
+   int* from = lower_bound(data, data + used, first);
+   int* to = upper_bound(from, data + used, last);
+   for (int* p = from; p != to; ++p)
+      hashSum -= mixHash(*p);
+   copy(to, data + used, from);
+   int removed = int(to - from);
+   used -= removed;
+   noteRemovals(removed);
+   return removed;
 }
 
 bool operator==(const IntSet& is1, const IntSet& is2)
 {
-   if (is1.isSubsetOf(is2)&&is2.isSubsetOf(is1))
-    return true;
-   else
-    return false;
+   return is1.size() == is2.size()
+          && is1.fingerprint() == is2.fingerprint()
+          && equal(is1.begin(), is1.end(), is2.begin());
+}
+
+bool equal(const IntSet& is1, const IntSet& is2)
+{
+   return is1 == is2;
 }
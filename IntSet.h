@@ -2,7 +2,32 @@
 // CLASS PROVIDED: IntSet (a container class for a set of
 //                 int values)
 //
-// CONSTANT
+// NOTE: IntSet is basic_set<int, intset_policy> (see basic_set.h), so
+//       code written against basic_set<T, Policy> works with IntSet
+//       too. It is an explicit specialization of basic_set, defined
+//       here, since its representation (below) does more than the
+//       basic_set policies can. Being a typedef, IntSet can't be
+//       forward-declared as "class IntSet;"; include this file.
+//
+// TYPEDEFS
+//   typedef basic_set<int, intset_policy> IntSet
+//   typedef int value_type
+//     IntSet::value_type is the type of the elements (as for
+//     basic_set).
+//   typedef const int* const_iterator
+//     IntSet::const_iterator is a read-only random-access iterator
+//     over the elements of an IntSet (see begin and end).
+//
+// CONSTANTS
+//   static const int INLINE_CAPACITY = ____
+//     IntSet::INLINE_CAPACITY is the # of distinct values an IntSet
+//     stores inside the IntSet object itself; an IntSet allocates
+//     dynamic memory only when it grows beyond INLINE_CAPACITY
+//     elements (so constructing, copying, assigning and the set
+//     algebra on small IntSet's are allocation-free).
+//   static const int PARALLEL_THRESHOLD = ____
+//     IntSet::PARALLEL_THRESHOLD is the combined size of the operands
+//     below which the parallel set operations don't start threads.
 //   static const int DEFAULT_CAPACITY = ____
 //     IntSet::DEFAULT_CAPACITY is the initial capacity of an
 //     IntSet that is created by the default constructor (i.e.,
@@ -15,8 +40,8 @@
 //     Post: The invoking IntSet is initialized to an empty
 //           IntSet (i.e., one containing no relevant elements);
 //           the initial capacity is given by initial_capacity if
-//           initial_capacity is >= 1, otherwise it is given by
-//           IntSet:DEFAULT_CAPACITY.
+//           initial_capacity is > INLINE_CAPACITY, otherwise it is
+//           given by IntSet::INLINE_CAPACITY.
 //     Note: When the IntSet is put to use after construction,
 //           its capacity will be resized as necessary.
 //
@@ -31,20 +56,97 @@
 //   bool contains(int anInt) const
 //     Pre:  (none)
 //     Post: true is returned if the invoking IntSet has anInt as an
-//           element, otherwise false is returned.
+//           element, otherwise false is returned. O(log n).
 //   bool isSubsetOf(const IntSet& otherIntSet) const
 //     Pre:  (none)
+//     Note: O(size() + otherIntSet.size()).
 //     Post: True is returned if all elements of the invoking IntSet
 //           are also elements of otherIntSet, otherwise false is
 //           returned.
 //           By definition, true is returned if the invoking IntSet
 //           is empty (i.e., an empty IntSet is always isSubsetOf
 //           another IntSet, even if the other IntSet is also empty).
+//   int rank(int anInt) const
+//     Pre:  (none)
+//     Post: The # of elements of the invoking IntSet that are less
+//           than anInt is returned. O(log n).
+//   int select(int k) const
+//     Pre:  0 <= k < size()
+//     Post: The k-th smallest element of the invoking IntSet is
+//           returned (k = 0 gives the smallest). O(1).
+//   int countInRange(int lo, int hi) const
+//     Pre:  (none)
+//     Post: The # of elements x of the invoking IntSet with
+//           lo <= x <= hi is returned (0 if lo > hi). O(log n).
+//   template <class Function>
+//   void forEachInRange(int lo, int hi, Function f) const
+//     Pre:  f can be called with an int argument.
+//     Post: f has been called on each element x of the invoking
+//           IntSet with lo <= x <= hi, in ascending order.
+//   template <class Function>
+//   void forEach(Function f) const
+//     Pre:  f can be called with an int argument.
+//     Post: f has been called on each element of the invoking IntSet,
+//           in ascending order (as for basic_set).
+//   unsigned long long fingerprint() const
+//     Pre:  (none)
+//     Post: A 64-bit hash of the elements of the invoking IntSet is
+//           returned. It does not depend on how the IntSet was built
+//           (equal IntSet's always have equal fingerprints) and is
+//           maintained incrementally, so this is O(1).
+//   bool hasFilter() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking IntSet has a membership
+//           filter enabled (see enableFilter), otherwise false.
+//   double filterFalsePositiveRate() const
+//     Pre:  (none)
+//     Post: The estimated fraction of lookups for values NOT in the
+//           invoking IntSet that the filter fails to reject (and so
+//           still search the elements) is returned, based on how
+//           full the filter currently is; 1.0 is returned if no
+//           filter is enabled.
+//   std::size_t filterMemory() const
+//     Pre:  (none)
+//     Post: The # of bytes used by the filter is returned (0 if no
+//           filter is enabled).
+//   const_iterator begin() const
+//   const_iterator end() const
+//     Pre:  (none)
+//     Post: Random-access iterators to the smallest element and to
+//           one past the largest element of the invoking IntSet are
+//           returned; traversal is in ascending order.
+//     Note: Iterators are invalidated by any mutator.
+//   const_iterator lowerBound(int anInt) const
+//   const_iterator upperBound(int anInt) const
+//     Pre:  (none)
+//     Post: An iterator to the first element >= anInt (lowerBound)
+//           or > anInt (upperBound) is returned, end() if none.
 //   void DumpData(std::ostream& out) const
 //     Pre:  (none)
 //     Post: Contents of the invoking IntSet have been inserted into
-//           out with 2 spaces separating one item from another if
-//           if there are 2 or more items.
+//           out in ascending order with 2 spaces separating one item
+//           from another if there are 2 or more items.
+//   void serialize(std::ostream& out, bool compact = true) const
+//     Pre:  out has been opened in binary mode.
+//     Post: Contents of the invoking IntSet have been written to out
+//           in the compact binary format described below (or, if
+//           compact is false, in the fixed-width format that an
+//           IntSetView can map); the invoking IntSet is unchanged.
+//     Note: FORMAT (all multi-byte fields are little-endian)
+//             bytes  0- 3  magic "ISB1"
+//             bytes  4- 7  number of elements (unsigned 32-bit)
+//             bytes  8-11  payload length in bytes (unsigned 32-bit)
+//             bytes 12-15  Adler-32 checksum of the payload
+//             bytes 16-    payload: the elements in ascending order,
+//                          each stored as the LEB128 varint of its
+//                          distance from the previous element (the
+//                          first from the lowest int value)
+//           A set of n clustered ints typically takes a little more
+//           than n bytes, versus ~12n characters for DumpData.
+//           The fixed-width format has the same header with magic
+//           "ISR1", and its payload is the elements in ascending
+//           order as 32-bit two's complement ints (so the payload
+//           starts 16-byte aligned and can be searched in place).
 //   IntSet unionWith(const IntSet& otherIntSet) const
 //     Pre:  (none)
 //     Post: An IntSet representing the union of the invoking IntSet
@@ -53,6 +155,8 @@
 //           returned is one that initially is an exact copy of the
 //           invoking IntSet but subsequently has all elements of
 //           otherIntSet added.
+//     Note: This and the next two operations merge the operands in
+//           O(size() + otherIntSet.size()).
 //   IntSet intersect(const IntSet& otherIntSet) const
 //     Pre:  (none)
 //     Post: An IntSet representing the intersection of the invoking
@@ -69,8 +173,88 @@
 //           returned is one that initially is an exact copy of the
 //           invoking IntSet but subsequently has all elements of
 //           otherIntSet removed.
+//   IntSet parallelUnionWith(const IntSet& otherIntSet,
+//                            int threadCount = 0) const
+//   IntSet parallelIntersect(const IntSet& otherIntSet,
+//                            int threadCount = 0) const
+//   IntSet parallelSubtract(const IntSet& otherIntSet,
+//                           int threadCount = 0) const
+//   bool parallelIsSubsetOf(const IntSet& otherIntSet,
+//                           int threadCount = 0) const
+//     Pre:  (none)
+//     Post: Same as unionWith, intersect, subtract and isSubsetOf,
+//           computed by up to threadCount threads (0 means one per
+//           hardware thread).
+//     Note: Both operands are split into the same value ranges at
+//           splitter values picked from the larger operand, and each
+//           thread merges one range. Each thread first counts its
+//           output, and then writes it straight into its slice of the
+//           result, so the result is allocated once and never copied.
+//           The threads are the calling thread plus workers from a
+//           pool that is started on first use and kept until exit; a
+//           call made while another one is using the pool runs on the
+//           calling thread alone. Operands with fewer than
+//           PARALLEL_THRESHOLD elements in total are handled by the
+//           sequential versions.
+//
+// STATIC MEMBER FUNCTIONS
+//   static IntSet intersectAll(const IntSet* const sets[], int count)
+//     Pre:  sets[0] through sets[count - 1] point to IntSet's.
+//     Post: An IntSet representing the intersection of all count
+//           IntSet's is returned (an empty IntSet if count <= 0).
+//     Note: The inputs are visited smallest first, and each element
+//           of the smallest is looked for by galloping (exponential
+//           then binary search) forward in each of the others, so
+//           the cost is about smallest size * count * log(gap). No
+//           intermediate IntSet's are built.
+//   static IntSet unionAll(const IntSet* const sets[], int count)
+//     Pre:  sets[0] through sets[count - 1] point to IntSet's.
+//     Post: An IntSet representing the union of all count IntSet's
+//           is returned (an empty IntSet if count <= 0).
+//     Note: The inputs are merged in smallest first, through two
+//           reusable scratch buffers, and the last merge writes into
+//           the result directly, so no intermediate IntSet's (and at
+//           most three allocations) are made.
 //
 // MODIFICATION MEMBER FUNCTIONS (MUTATORS)
+//   bool deserialize(std::istream& in)
+//     Pre:  in has been opened in binary mode.
+//     Post: If a well-formed serialized IntSet (in either format of
+//           serialize) could be read from in, the invoking IntSet
+//           has been made to contain exactly its elements and true
+//           is returned, otherwise the invoking IntSet is unchanged
+//           and false is returned.
+//     Note: The payload is read 1 MB at a time, so memory use is
+//           bounded by the bytes in the stream, not by the length
+//           its header claims.
+//   bool deserialize(const unsigned char* buffer, std::size_t length)
+//     Pre:  buffer points to (at least) length readable bytes, e.g.
+//           a memory-mapped snapshot file.
+//     Post: Same as above, except that the serialized IntSet is
+//           decoded in place from buffer, without any intermediate
+//           copy of the bytes.
+//   void enableFilter(int bitsPerElement = 10)
+//     Pre:  bitsPerElement >= 1
+//     Post: The invoking IntSet has (re)built a blocked Bloom filter
+//           of about bitsPerElement bits per element, through which
+//           contains rejects most absent values by reading a single
+//           64-byte block. More bits per element give fewer false
+//           positives at more memory (10 bits ~ 1%, 16 bits ~ 0.1%).
+//     Note: The filter is kept up to date by add and reset and by
+//           deserialize. Removals leave stale bits behind (which
+//           are harmless) and only count them, so a loop of remove
+//           calls stays O(n) per call. Once they amount to a quarter
+//           of the filter's sizing the next contains rebuilds the
+//           filter first (O(n), amortized over those removals);
+//           hence an IntSet with a filter that is being read from
+//           several threads must not have been removed from since
+//           it was last looked up (ConcurrentIntSet sees to this
+//           for the versions it publishes). IntSet's
+//           returned by the set algebra start without a filter;
+//           copies and assignment carry the filter along.
+//   void disableFilter()
+//     Pre:  (none)
+//     Post: The invoking IntSet has no filter.
 //   void reset()
 //     Pre:  (none)
 //     Post: The invoking IntSet is reset to become an empty IntSet.
@@ -87,6 +271,28 @@
 //           removed from the invoking IntSet and true is
 //           returned, otherwise the invoking IntSet is unchanged
 //           and false is returned.
+//   int removeAll(const IntSet& otherIntSet)
+//     Pre:  (none)
+//     Post: All elements of otherIntSet have been removed from the
+//           invoking IntSet and the # of elements removed is
+//           returned.
+//     Note: Single merge pass, O(size() + otherIntSet.size()),
+//           versus O(otherIntSet.size() * size()) for a loop of
+//           remove calls.
+//   int removeRange(int first, int last)
+//     Pre:  (none)
+//     Post: All elements x with first <= x <= last have been removed
+//           from the invoking IntSet and the # of elements removed
+//           is returned (0 if first > last).
+//   template <class Predicate>
+//   int retainIf(Predicate pred)
+//     Pre:  pred can be called with an int argument and returns a
+//           value convertible to bool.
+//     Post: Every element x for which pred(x) is false has been
+//           removed from the invoking IntSet (pred is called once
+//           per element, in ascending order) and the # of elements
+//           removed is returned.
+//     Note: The remaining elements are compacted in a single pass.
 //
 // NON-MEMBER FUNCTIONS
 //   bool operator==(const IntSet& is1, const IntSet& is2)
@@ -95,6 +301,13 @@
 //           otherwise false is returned; for e.g.: {1,2,3}, {1,3,2},
 //           {2,1,3}, {2,3,1}, {3,1,2}, and {3,2,1} are all equal.
 //     Note: By definition, two empty IntSet's are equal.
+//     Note: IntSet's that differ in size or fingerprint are rejected
+//           in O(1); otherwise the elements are compared in one
+//           linear pass.
+//   bool equal(const IntSet& is1, const IntSet& is2)
+//     Pre:  (none)
+//     Post: Same as is1 == is2 (the name the earlier IntSet's used,
+//           kept so code such as Assign01.cpp still builds).
 //
 // VALUE SEMANTICS
 //   Assignment and the copy constructor may be used with IntSet
@@ -104,34 +317,136 @@
 #define INT_SET_H
 
 #include <iostream>
+#include <cstddef>  // provides size_t
+#include "basic_set.h"
+
+template <>
+class basic_set<int, intset_policy>;
+typedef basic_set<int, intset_policy> IntSet;
 
-class IntSet
+template <>
+class basic_set<int, intset_policy>
 {
 public:
-   static const int DEFAULT_CAPACITY = 1;
-   IntSet(int initial_capacity = DEFAULT_CAPACITY);
-   IntSet(const IntSet& src);
-   ~IntSet();
+   typedef int value_type;
+   typedef const int* const_iterator;
+   static const int INLINE_CAPACITY = 8;
+   static const int DEFAULT_CAPACITY = INLINE_CAPACITY;
+   static const int PARALLEL_THRESHOLD = 1 << 16;
+   basic_set(int initial_capacity = DEFAULT_CAPACITY);
+   basic_set(const IntSet& src);
+   ~basic_set();
    IntSet& operator=(const IntSet& rhs);
    int size() const;
    bool isEmpty() const;
    bool contains(int anInt) const;
    bool isSubsetOf(const IntSet& otherIntSet) const;
+   int rank(int anInt) const;
+   int select(int k) const;
+   int countInRange(int lo, int hi) const;
+   unsigned long long fingerprint() const;
+   template <class Function>
+   void forEachInRange(int lo, int hi, Function f) const;
+   template <class Function>
+   void forEach(Function f) const;
+   bool hasFilter() const;
+   double filterFalsePositiveRate() const;
+   std::size_t filterMemory() const;
+   const_iterator begin() const;
+   const_iterator end() const;
+   const_iterator lowerBound(int anInt) const;
+   const_iterator upperBound(int anInt) const;
    void DumpData(std::ostream& out) const;
+   void serialize(std::ostream& out, bool compact = true) const;
    IntSet unionWith(const IntSet& otherIntSet) const;
    IntSet intersect(const IntSet& otherIntSet) const;
    IntSet subtract(const IntSet& otherIntSet) const;
+   IntSet parallelUnionWith(const IntSet& otherIntSet,
+                            int threadCount = 0) const;
+   IntSet parallelIntersect(const IntSet& otherIntSet,
+                            int threadCount = 0) const;
+   IntSet parallelSubtract(const IntSet& otherIntSet,
+                           int threadCount = 0) const;
+   bool parallelIsSubsetOf(const IntSet& otherIntSet,
+                           int threadCount = 0) const;
+   static IntSet intersectAll(const IntSet* const sets[], int count);
+   static IntSet unionAll(const IntSet* const sets[], int count);
+   bool deserialize(std::istream& in);
+   bool deserialize(const unsigned char* buffer, std::size_t length);
+   void enableFilter(int bitsPerElement = 10);
+   void disableFilter();
    void reset();
    bool add(int anInt);
    bool remove(int anInt);
+   int removeAll(const IntSet& otherIntSet);
+   int removeRange(int first, int last);
+   template <class Predicate>
+   int retainIf(Predicate pred);
 
 private:
+   friend class IntSetView;
+   friend class ConcurrentIntSet;
    int* data;
    int  capacity;
    int  used;
+   int  inlineData[INLINE_CAPACITY];
+   unsigned long long hashSum;
+   static const int FILTER_BLOCK_WORDS = 8;   // 64-byte blocks
+   // the filter is a cache that contains may rebuild (see refreshFilter)
+   mutable unsigned long long* filterStorage;
+   mutable unsigned long long* filter;
+   mutable int filterBlocks;
+   int filterBitsPerElement;
+   mutable int filterCapacity;
+   mutable int filterStale;
+   enum SetOperation { UNION_OP, INTERSECT_OP, SUBTRACT_OP };
+   static unsigned long long mixHash(int anInt);
+   void rehash();
+   IntSet parallelSetOperation(const IntSet& otherIntSet,
+                               SetOperation operation,
+                               int threadCount) const;
    void resize(int new_capacity);
+   int filterHashes() const;
+   bool filterMayContain(int anInt) const;
+   void filterInsert(int anInt) const;
+   void allocateFilter(int blocks) const;
+   void rebuildFilter() const;
+   void refreshFilter() const;
+   void noteRemovals(int removed);
 };
 
 bool operator==(const IntSet& is1, const IntSet& is2);
+bool equal(const IntSet& is1, const IntSet& is2);
+
+template <class Function>
+void IntSet::forEachInRange(int lo, int hi, Function f) const
+{
+   for (const_iterator it = lowerBound(lo); it != end() && *it <= hi; ++it)
+      f(*it);
+}
+
+template <class Function>
+void IntSet::forEach(Function f) const
+{
+   for (const_iterator it = begin(); it != end(); ++it)
+      f(*it);
+}
+
+template <class Predicate>
+int IntSet::retainIf(Predicate pred)
+{
+   int kept = 0;
+   for (int i = 0; i < used; ++i)
+   {
+      if (pred(data[i]))
+         data[kept++] = data[i];
+      else
+         hashSum -= mixHash(data[i]);
+   }
+   int removed = used - kept;
+   used = kept;
+   noteRemovals(removed);
+   return removed;
+}
 
 #endif
@@ -0,0 +1,116 @@
+// FILE: IntSetMultiwayBench.cpp
+// A non-interactive benchmark of IntSet::intersectAll and unionAll.
+//
+// DESCRIPTION:
+// For 20 and 50 IntSet's of random elements (each a random subset of
+// 0 ... 4000000), intersectAll is timed against chaining intersect
+// calls in the order given, and unionAll against chaining unionWith
+// calls. Two shapes of input are used:
+//   skewed:  the first set has 2000 elements, the others 1000000
+//            (a rare term among common ones, posting-list style)
+//   uniform: every set has 200000 elements
+// Each time is the average of REPEATS calls, in milliseconds, and is
+// printed with the speedup over the chain and the size of the result.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 -pthread IntSetMultiwayBench.cpp IntSet.cpp
+//       -o ismb
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "IntSet.h"
+using namespace std;
+
+const int RANGE = 4000000;
+const int REPEATS = 3;
+
+double millisecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, milli> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// About count random elements of 0 ... RANGE - 1 (each value is kept
+// with probability count / RANGE, in ascending order so each add
+// appends).
+IntSet randomSet(int count, unsigned long long seed)
+{
+   IntSet result(count + count / 8);
+   unsigned long long state = seed;
+   for (int x = 0; x < RANGE; ++x)
+   {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      if ((state >> 33) % RANGE < (unsigned long long)count)
+         result.add(x);
+   }
+   return result;
+}
+
+// Average milliseconds per call of operation(); size is set to the
+// size of the result.
+template <class Operation>
+double timeCalls(Operation operation, int& size)
+{
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   for (int r = 0; r < REPEATS; ++r)
+      size = operation().size();
+   return millisecondsSince(begin) / REPEATS;
+}
+
+void benchmark(const char* shape, int sets, int firstSize, int otherSize)
+{
+   vector<IntSet> inputs;
+   vector<const IntSet*> pointers;
+   for (int i = 0; i < sets; ++i)
+      inputs.push_back(randomSet(i == 0 ? firstSize : otherSize, i + 1));
+   for (int i = 0; i < sets; ++i)
+      pointers.push_back(&inputs[i]);
+
+   int chainSize, allSize;
+   double chain = timeCalls([&]()
+                            {
+                               IntSet result = inputs[0];
+                               for (int i = 1; i < sets; ++i)
+                                  result = result.intersect(inputs[i]);
+                               return result;
+                            }, chainSize);
+   double all = timeCalls([&]()
+                          {
+                             return IntSet::intersectAll(&pointers[0], sets);
+                          }, allSize);
+   cout << setw(8) << shape << setw(6) << sets << setw(11) << "intersect"
+        << setw(12) << chain << setw(12) << all
+        << setw(9) << chain / all << "x" << setw(10) << allSize
+        << (chainSize == allSize ? "" : "  mismatch") << "\n";
+
+   chain = timeCalls([&]()
+                     {
+                        IntSet result = inputs[0];
+                        for (int i = 1; i < sets; ++i)
+                           result = result.unionWith(inputs[i]);
+                        return result;
+                     }, chainSize);
+   all = timeCalls([&]()
+                   {
+                      return IntSet::unionAll(&pointers[0], sets);
+                   }, allSize);
+   cout << setw(8) << shape << setw(6) << sets << setw(11) << "union"
+        << setw(12) << chain << setw(12) << all
+        << setw(9) << chain / all << "x" << setw(10) << allSize
+        << (chainSize == allSize ? "" : "  mismatch") << "\n";
+}
+
+int main()
+{
+   cout << fixed << setprecision(2)
+        << "   shape  sets  operation  chain (ms)    all (ms)  speedup"
+        << "    result\n";
+   benchmark("skewed", 20, 2000, 1000000);
+   benchmark("skewed", 50, 2000, 1000000);
+   benchmark("uniform", 20, 200000, 200000);
+   benchmark("uniform", 50, 200000, 200000);
+   return 0;
+}
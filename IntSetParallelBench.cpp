@@ -0,0 +1,109 @@
+// FILE: IntSetParallelBench.cpp
+// A non-interactive benchmark of the parallel IntSet set operations.
+//
+// DESCRIPTION:
+// For two operand sizes (PARALLEL_THRESHOLD elements in total, the
+// smallest that is run in parallel, and 2^21 in total), two IntSet's
+// of random elements are built, and unionWith and intersect are timed
+// against parallelUnionWith and parallelIntersect with 1, 2, 4, ...
+// threads (up to twice the hardware threads, at least 8). Each time is
+// the average of REPEATS calls, in microseconds, and is printed along
+// with the speedup over the sequential version. With 1 thread the
+// parallel versions just call the sequential ones; with more threads
+// than cores, the two passes over each slice show up as a slowdown.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 -pthread IntSetParallelBench.cpp IntSet.cpp
+//       -o ispb
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include "IntSet.h"
+using namespace std;
+
+const int REPEATS = 20;
+
+double microsecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, micro> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// count random elements, 1 to 7 apart (so the sets made with two seeds
+// overlap by about a quarter), the same for every run. They are added
+// in ascending order, so each add appends.
+IntSet randomSet(int count, unsigned seed)
+{
+   IntSet result(count);
+   unsigned long long state = seed;
+   int value = 0;
+   for (int i = 0; i < count; ++i)
+   {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      value += 1 + int((state >> 24) % 7);
+      result.add(value);
+   }
+   return result;
+}
+
+// Average microseconds per call of operation(a, b, threads); threads
+// is 0 for the sequential version.
+template <class Operation>
+double timeCalls(Operation operation, const IntSet& a, const IntSet& b,
+                 int threads)
+{
+   int total = 0;
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   for (int r = 0; r < REPEATS; ++r)
+      total += operation(a, b, threads).size();
+   double elapsed = microsecondsSince(begin) / REPEATS;
+   // the sizes keep the work from being optimized away
+   if (total < 0)
+      cout << total;
+   return elapsed;
+}
+
+IntSet unionCall(const IntSet& a, const IntSet& b, int threads)
+{
+   return threads == 0 ? a.unionWith(b) : a.parallelUnionWith(b, threads);
+}
+
+IntSet intersectCall(const IntSet& a, const IntSet& b, int threads)
+{
+   return threads == 0 ? a.intersect(b) : a.parallelIntersect(b, threads);
+}
+
+int main()
+{
+   int maxThreads = 2 * int(thread::hardware_concurrency());
+   if (maxThreads < 8)
+      maxThreads = 8;
+   cout << "hardware threads: " << thread::hardware_concurrency() << "\n"
+        << fixed << setprecision(1);
+   for (int total = IntSet::PARALLEL_THRESHOLD; total <= (1 << 21);
+        total *= 32)
+   {
+      IntSet a = randomSet(total / 2, 1);
+      IntSet b = randomSet(total / 2, 2);
+      double unionBase = timeCalls(unionCall, a, b, 0);
+      double intersectBase = timeCalls(intersectCall, a, b, 0);
+      cout << "\nelements " << total
+           << "  sequential: union " << unionBase << " us, intersect "
+           << intersectBase << " us\n"
+           << "threads   union (us)  speedup   intersect (us)  speedup\n";
+      for (int threads = 1; threads <= maxThreads; threads *= 2)
+      {
+         double unionTime = timeCalls(unionCall, a, b, threads);
+         double intersectTime = timeCalls(intersectCall, a, b, threads);
+         cout << setw(7) << threads
+              << setw(13) << unionTime
+              << setw(8) << unionBase / unionTime << "x"
+              << setw(17) << intersectTime
+              << setw(8) << intersectBase / intersectTime << "x\n";
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,108 @@
+// FILE: IntSetRemoveBench.cpp
+// A non-interactive benchmark of the batched IntSet removals.
+//
+// DESCRIPTION:
+// For N = 100000 and 1000000 elements, REMOVED elements spread evenly
+// through the set are removed in two ways each:
+//   removeAll:  a loop of remove calls, versus one removeAll call
+//   retainIf:   a loop of remove calls on every element the predicate
+//               rejects, versus one retainIf call
+// and a block of REMOVED consecutive values is removed by a loop of
+// remove calls versus one removeRange call. The times are printed in
+// milliseconds, along with the speedup of the batched functions.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 -pthread IntSetRemoveBench.cpp IntSet.cpp
+//       -o isrb
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "IntSet.h"
+using namespace std;
+
+const int REMOVED = 10000;
+
+double millisecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, milli> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// The even values 0, 2, ..., 2 * (n - 1) (added in order, so each add
+// appends).
+IntSet evens(int n)
+{
+   IntSet result(n);
+   for (int i = 0; i < n; ++i)
+      result.add(2 * i);
+   return result;
+}
+
+// Picks every (n / REMOVED)th element of evens(n) to be removed.
+struct Spread
+{
+   int step;
+   explicit Spread(int n) : step(2 * (n / REMOVED)) { }
+   bool operator()(int anInt) const { return anInt % step != 0; }
+};
+
+// Prints one row: the loop time, the batched time and the speedup.
+void row(const char* name, int n, double loopTime, double batchTime)
+{
+   cout << setw(12) << name << setw(10) << n
+        << setw(12) << loopTime << setw(12) << batchTime
+        << setw(9) << loopTime / batchTime << "x\n";
+}
+
+int main()
+{
+   cout << fixed << setprecision(2)
+        << "    function  elements  loop (ms) batch (ms)  speedup\n";
+   for (int n = 100000; n <= 1000000; n *= 10)
+   {
+      Spread keep(n);
+      IntSet toRemove;
+      for (int x = 0; x < 2 * n; x += keep.step)
+         toRemove.add(x);
+
+      IntSet looped = evens(n);
+      chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+      for (IntSet::const_iterator it = toRemove.begin();
+           it != toRemove.end(); ++it)
+         looped.remove(*it);
+      double loopTime = millisecondsSince(begin);
+      IntSet batched = evens(n);
+      begin = chrono::steady_clock::now();
+      batched.removeAll(toRemove);
+      row("removeAll", n, loopTime, millisecondsSince(begin));
+
+      looped = evens(n);
+      begin = chrono::steady_clock::now();
+      for (int i = 0; i < n; ++i)
+         if (!keep(2 * i))
+            looped.remove(2 * i);
+      loopTime = millisecondsSince(begin);
+      batched = evens(n);
+      begin = chrono::steady_clock::now();
+      batched.retainIf(keep);
+      row("retainIf", n, loopTime, millisecondsSince(begin));
+
+      int first = n - REMOVED;   // a block from the middle
+      looped = evens(n);
+      begin = chrono::steady_clock::now();
+      for (int x = first; x < first + 2 * REMOVED; x += 2)
+         looped.remove(x);
+      loopTime = millisecondsSince(begin);
+      batched = evens(n);
+      begin = chrono::steady_clock::now();
+      batched.removeRange(first, first + 2 * REMOVED - 1);
+      row("removeRange", n, loopTime, millisecondsSince(begin));
+
+      // the loops and the batched calls must agree
+      if (!(looped == batched))
+         cout << "mismatch\n";
+   }
+   return 0;
+}
@@ -0,0 +1,138 @@
+// FILE: IntSetView.cpp
+//       Implementation file for the IntSetView class
+//       (See IntSetView.h for documentation.)
+// INVARIANT for the IntSetView class:
+// (1) If the view is closed, mapping is 0, mappedLength is 0, data
+//     is 0 and used is 0.
+// (2) If the view is open, mapping references a read-only, shared
+//     mapping of mappedLength bytes (the whole file), data references
+//     the first element of the payload within that mapping and used
+//     is the number of elements.
+// (3) data[0] through data[used - 1] hold the distinct elements of
+//     the set in strictly ascending order; the file format (see
+//     IntSet::serialize) guarantees this, and it is what makes
+//     contains a binary search and isSubsetOf and intersect a single
+//     merge pass against the (also sorted) IntSet.
+
+#include "IntSetView.h"
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+static const size_t VIEW_HEADER_SIZE = 16;
+
+static unsigned int getUint32(const unsigned char* src)
+{
+   return static_cast<unsigned int>(src[0])
+          | (static_cast<unsigned int>(src[1]) << 8)
+          | (static_cast<unsigned int>(src[2]) << 16)
+          | (static_cast<unsigned int>(src[3]) << 24);
+}
+
+static bool hostIsLittleEndian()
+{
+   const unsigned int probe = 1;
+   return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+IntSetView::IntSetView() : mapping(0), mappedLength(0), data(0), used(0) { }
+
+IntSetView::~IntSetView()
+{
+   close();
+}
+
+bool IntSetView::isOpen() const
+{
+   return mapping != 0;
+}
+
+int IntSetView::size() const
+{
+   return used;
+}
+
+bool IntSetView::isEmpty() const
+{
+   return used == 0;
+}
+
+bool IntSetView::contains(int anInt) const
+{
+   return binary_search(data, data + used, anInt);
+}
+
+bool IntSetView::isSubsetOf(const IntSet& otherIntSet) const
+{
+   // both sides are sorted, so one merge pass over them decides it
+   return used <= otherIntSet.used
+          && includes(otherIntSet.data, otherIntSet.data + otherIntSet.used,
+                      data, data + used);
+}
+
+IntSet IntSetView::intersect(const IntSet& otherIntSet) const
+{
+   // one merge pass, written straight into a result sized up front
+   IntSet result(used < otherIntSet.used ? used : otherIntSet.used);
+
+   result.used = int(set_intersection(data, data + used, otherIntSet.data,
+                                      otherIntSet.data + otherIntSet.used,
+                                      result.data)
+                     - result.data);
+   result.rehash();
+   return result;
+}
+
+bool IntSetView::open(const char* fileName)
+{
+   close();
+   if (!hostIsLittleEndian())
+      return false;
+
+   int fd = ::open(fileName, O_RDONLY);
+   if (fd < 0)
+      return false;
+   struct stat info;
+   if (fstat(fd, &info) != 0
+       || static_cast<size_t>(info.st_size) < VIEW_HEADER_SIZE)
+   {
+      ::close(fd);
+      return false;
+   }
+   size_t length = static_cast<size_t>(info.st_size);
+   void* mapped = mmap(0, length, PROT_READ, MAP_SHARED, fd, 0);
+   ::close(fd);   // the mapping keeps its own reference to the file
+   if (mapped == MAP_FAILED)
+      return false;
+
+   const unsigned char* bytes = static_cast<const unsigned char*>(mapped);
+   size_t count = getUint32(bytes + 4);
+   size_t payloadLength = getUint32(bytes + 8);
+   if (bytes[0] != 'I' || bytes[1] != 'S' || bytes[2] != 'R'
+       || bytes[3] != '1' || count > 0x7FFFFFFFu
+       || payloadLength != 4 * count
+       || payloadLength > length - VIEW_HEADER_SIZE)
+   {
+      munmap(mapped, length);
+      return false;
+   }
+
+   mapping = mapped;
+   mappedLength = length;
+   data = reinterpret_cast<const int*>(bytes + VIEW_HEADER_SIZE);
+   used = static_cast<int>(count);
+   return true;
+}
+
+void IntSetView::close()
+{
+   if (mapping != 0)
+      munmap(mapping, mappedLength);
+   mapping = 0;
+   mappedLength = 0;
+   data = 0;
+   used = 0;
+}
@@ -0,0 +1,92 @@
+// FILE: IntSetView.h - header file for IntSetView class
+// CLASS PROVIDED: IntSetView (a read-only view of a set of int
+//                 values stored in a file written by
+//                 IntSet::serialize(out, false))
+//
+// CONSTRUCTOR
+//   IntSetView()
+//     Post: The invoking IntSetView is initialized to a closed view,
+//           which behaves as an empty set.
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS)
+//   bool isOpen() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking IntSetView currently
+//           maps a file, otherwise false is returned.
+//   int size() const
+//     Pre:  (none)
+//     Post: Number of elements in the invoking IntSetView is returned.
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking IntSetView has no
+//           elements, otherwise false is returned.
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: true is returned if the invoking IntSetView has anInt as
+//           an element, otherwise false is returned.
+//     Note: Binary search over the mapped pages; O(log n).
+//   bool isSubsetOf(const IntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: True is returned if all elements of the invoking
+//           IntSetView are also elements of otherIntSet, otherwise
+//           false is returned.
+//     Note: One merge pass, O(size() + otherIntSet.size()).
+//   IntSet intersect(const IntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: An IntSet representing the intersection of the invoking
+//           IntSetView and otherIntSet is returned.
+//     Note: One merge pass, O(size() + otherIntSet.size()); the
+//           result is allocated once.
+//
+// MODIFICATION MEMBER FUNCTIONS (MUTATORS)
+//   bool open(const char* fileName)
+//     Pre:  fileName names a file written by IntSet::serialize with
+//           compact == false, on a little-endian host.
+//     Post: Any file previously mapped has been unmapped. If fileName
+//           could be opened and has a valid header, its contents have
+//           been mapped read-only and shared (so all processes viewing
+//           the same file share one copy in the page cache) and true
+//           is returned, otherwise the invoking IntSetView is closed
+//           and false is returned.
+//     Note: Only the header is examined; the elements are neither
+//           parsed nor copied, and the payload checksum is NOT
+//           verified (use IntSet::deserialize for that).
+//   void close()
+//     Pre:  (none)
+//     Post: Any file previously mapped has been unmapped and the
+//           invoking IntSetView is closed.
+//
+// VALUE SEMANTICS
+//   Assignment and the copy constructor may NOT be used with
+//   IntSetView objects.
+
+#ifndef INT_SET_VIEW_H
+#define INT_SET_VIEW_H
+
+#include <cstddef>  // provides size_t
+#include "IntSet.h"
+
+class IntSetView
+{
+public:
+   IntSetView();
+   ~IntSetView();
+   bool isOpen() const;
+   int size() const;
+   bool isEmpty() const;
+   bool contains(int anInt) const;
+   bool isSubsetOf(const IntSet& otherIntSet) const;
+   IntSet intersect(const IntSet& otherIntSet) const;
+   bool open(const char* fileName);
+   void close();
+
+private:
+   void*       mapping;
+   std::size_t mappedLength;
+   const int*  data;
+   int         used;
+   IntSetView(const IntSetView& src);
+   IntSetView& operator=(const IntSetView& rhs);
+};
+
+#endif
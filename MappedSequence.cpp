@@ -0,0 +1,265 @@
+// FILE: MappedSequence.cpp
+// CLASS IMPLEMENTED: mapped_sequence (see MappedSequence.h for
+//                    documentation)
+// INVARIANT for the mapped_sequence ADT:
+//   1. If the mapped_sequence is closed, fd is -1 and mapping, header
+//      and data are 0 (mapped_length is 0).
+//   2. If it is open, fd is the open file, mapping is a shared
+//      read/write mapping of its first mapped_length bytes, header
+//      points to the file header (at the start of mapping) and data
+//      to the item slots right after it.
+//   3. The sequence's state lives in the header, so it is saved with
+//      the items: header->used is the number of items, stored in
+//      data[0] through data[header->used - 1]; header->capacity is
+//      the number of slots, and mapped_length is exactly
+//      HEADER_SIZE + header->capacity * sizeof(value_type).
+//   4. header->current_index is the index of the current item, or
+//      header->used if there is no current item (as for sequence).
+//
+// DOCUMENTATION for private member (helper) functions:
+//   bool map(size_type capacity)
+//    Pre:  fd is open and its file is at least HEADER_SIZE + capacity
+//      * sizeof(value_type) bytes long.
+//    Post: If mapping is 0, that much of the file has been mapped;
+//      otherwise the existing mapping has been resized to it (moving
+//      it if need be). header and data have been set and true is
+//      returned, or false if the mapping failed (the old mapping, if
+//      any, is then unchanged).
+//
+//   bool grow_if_full()
+//    Pre:  is_open() returns true.
+//    Post: If the file was full, it has been grown (see insert in
+//      MappedSequence.h); false is returned only if that failed.
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include "MappedSequence.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+namespace
+{
+   constexpr size_t HEADER_SIZE = 32;
+   const char MAGIC[4] = { 'M', 'S', 'Q', '1' };
+
+   bool host_is_little_endian()
+   {
+      const unsigned int probe = 1;
+      return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+   }
+}
+
+namespace CS3358_FA2021
+{
+   // CONSTRUCTOR and DESTRUCTOR
+   mapped_sequence::mapped_sequence()
+      : fd(-1), mapping(0), mapped_length(0), header(0), data(0) { }
+
+   mapped_sequence::~mapped_sequence()
+   {
+      close();
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   bool mapped_sequence::open(const char* file_name,
+                              size_type initial_capacity)
+   {
+      static_assert(sizeof(file_header) == HEADER_SIZE,
+                    "file_header must match the file format");
+      close();
+      if (!host_is_little_endian())
+         return false;
+      if (initial_capacity < 1)
+         initial_capacity = 1;
+
+      fd = ::open(file_name, O_RDWR | O_CREAT, 0644);
+      if (fd < 0)
+         return false;
+      struct stat info;
+      if (fstat(fd, &info) != 0)
+      {
+         close();
+         return false;
+      }
+
+      if (info.st_size == 0)
+      {
+         // new file: write a header for an empty sequence
+         if (ftruncate(fd, HEADER_SIZE + initial_capacity * sizeof(value_type))
+             != 0 || !map(initial_capacity))
+         {
+            close();
+            return false;
+         }
+         memcpy(header->magic, MAGIC, sizeof MAGIC);
+         header->reserved = 0;
+         header->used = header->current_index = 0;
+         header->capacity = initial_capacity;
+         return true;
+      }
+
+      // existing file: check the header before trusting its capacity
+      size_t length = static_cast<size_t>(info.st_size);
+      file_header saved;
+      if (length < HEADER_SIZE
+          || pread(fd, &saved, sizeof saved, 0) != ssize_t(sizeof saved)
+          || memcmp(saved.magic, MAGIC, sizeof MAGIC) != 0
+          || saved.capacity < 1
+          || saved.capacity > (length - HEADER_SIZE) / sizeof(value_type)
+          || saved.used > saved.capacity
+          || saved.current_index > saved.used
+          || !map(saved.capacity))
+      {
+         close();
+         return false;
+      }
+      return true;
+   }
+
+   bool mapped_sequence::flush()
+   {
+      return mapping == 0 || msync(mapping, mapped_length, MS_SYNC) == 0;
+   }
+
+   void mapped_sequence::close()
+   {
+      if (mapping != 0)
+         munmap(mapping, mapped_length);
+      if (fd >= 0)
+         ::close(fd);
+      fd = -1;
+      mapping = 0;
+      mapped_length = 0;
+      header = 0;
+      data = 0;
+   }
+
+   bool mapped_sequence::reserve(size_type min_capacity)
+   {
+      assert(is_open());
+      if (min_capacity <= header->capacity)
+         return true;
+      // (a capacity whose byte length overflows off_t can't be had)
+      if (min_capacity > (size_type(numeric_limits<off_t>::max())
+                          - HEADER_SIZE) / sizeof(value_type))
+         return false;
+      if (ftruncate(fd, HEADER_SIZE + min_capacity * sizeof(value_type)) != 0)
+         return false;
+      if (!map(min_capacity))
+      {
+         // put the file back the way it was (the old mapping is still
+         // valid, since a failed mremap leaves it in place); if even
+         // that fails, nothing more can be trusted to work, so close
+         if (ftruncate(fd, mapped_length) != 0)
+            close();
+         return false;
+      }
+      header->capacity = min_capacity;
+      return true;
+   }
+
+   void mapped_sequence::start()
+   {
+      if (header != 0)
+         header->current_index = 0;
+   }
+
+   void mapped_sequence::advance()
+   {
+      if (is_item())
+         ++header->current_index;
+   }
+
+   bool mapped_sequence::insert(const value_type& entry)
+   {
+      assert(is_open());
+      if (!grow_if_full())
+         return false;
+      if (!is_item())
+         header->current_index = 0;
+      size_type index = header->current_index;
+      memmove(data + index + 1, data + index,
+              (header->used - index) * sizeof(value_type));
+      data[index] = entry;
+      ++header->used;
+      return true;
+   }
+
+   bool mapped_sequence::attach(const value_type& entry)
+   {
+      assert(is_open());
+      if (!grow_if_full())
+         return false;
+      if (is_item())
+         ++header->current_index;
+      else
+         header->current_index = header->used;
+      size_type index = header->current_index;
+      memmove(data + index + 1, data + index,
+              (header->used - index) * sizeof(value_type));
+      data[index] = entry;
+      ++header->used;
+      return true;
+   }
+
+   void mapped_sequence::remove_current()
+   {
+      assert(is_item());
+      size_type index = header->current_index;
+      memmove(data + index, data + index + 1,
+              (header->used - index - 1) * sizeof(value_type));
+      --header->used;
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   bool mapped_sequence::is_open() const
+   {
+      return mapping != 0;
+   }
+
+   mapped_sequence::size_type mapped_sequence::size() const
+   {
+      return header != 0 ? header->used : 0;
+   }
+
+   bool mapped_sequence::is_item() const
+   {
+      return header != 0 && header->current_index < header->used;
+   }
+
+   mapped_sequence::value_type mapped_sequence::current() const
+   {
+      assert(is_item());
+      return data[header->current_index];
+   }
+
+   // PRIVATE HELPER FUNCTIONS
+   bool mapped_sequence::map(size_type capacity)
+   {
+      size_t length = HEADER_SIZE + capacity * sizeof(value_type);
+      void* mapped;
+      if (mapping == 0)
+         mapped = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      else
+         mapped = mremap(mapping, mapped_length, length, MREMAP_MAYMOVE);
+      if (mapped == MAP_FAILED)
+         return false;
+      mapping = mapped;
+      mapped_length = length;
+      header = static_cast<file_header*>(mapped);
+      data = reinterpret_cast<value_type*>(static_cast<char*>(mapped)
+                                           + HEADER_SIZE);
+      return true;
+   }
+
+   bool mapped_sequence::grow_if_full()
+   {
+      if (header->used < header->capacity)
+         return true;
+      return reserve(header->capacity + header->capacity / 2 + 1);
+   }
+}
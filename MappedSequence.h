@@ -0,0 +1,168 @@
+// FILE: MappedSequence.h
+// CLASS PROVIDED: mapped_sequence (part of the namespace CS3358_FA2021)
+//
+// A mapped_sequence is a sequence (see Sequence.h) whose items live
+// in a file rather than in memory allocated with new. The file is
+// memory-mapped, so opening an existing sequence takes the same time
+// however many items it has (the items are paged in as they are
+// used), and every change is made directly to the mapped file.
+//
+// FILE FORMAT (host byte order, little-endian hosts only):
+//   bytes  0 -  3  the magic "MSQ1"
+//   bytes  4 -  7  reserved (0)
+//   bytes  8 - 15  used (# of items)
+//   bytes 16 - 23  current_index (used if there is no current item)
+//   bytes 24 - 31  capacity (# of item slots that follow)
+//   bytes 32 - ... capacity doubles; the first used are the items,
+//                  in order
+//
+// TYPEDEFS and MEMBER CONSTANTS for the mapped_sequence class:
+//   typedef ____ value_type
+//    mapped_sequence::value_type is the data type of the items in the
+//    mapped_sequence (double, so the file can be mapped as is).
+//
+//   typedef ____ size_type
+//    mapped_sequence::size_type is the data type of any variable that
+//    keeps track of how many items are in a mapped_sequence.
+//
+//   static const size_type DEFAULT_CAPACITY = _____
+//    mapped_sequence::DEFAULT_CAPACITY is the initial capacity of a
+//    file created by open when no capacity is given.
+//
+// CONSTRUCTOR for the mapped_sequence class:
+//   mapped_sequence()
+//    Pre:  none
+//    Post: The mapped_sequence has been initialized as closed; a
+//      closed mapped_sequence behaves as an empty sequence with no
+//      current item.
+//
+// MODIFICATION MEMBER FUNCTIONS for the mapped_sequence class:
+//   bool open(const char* file_name,
+//             size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  none
+//    Post: Any file previously open has been closed. If file_name
+//      names a file in the format above, it has been mapped (read and
+//      write, shared) and its items and current item are those saved
+//      in it; if there is no such file, an empty one with room for
+//      initial_capacity items (at least 1) has been created and
+//      mapped. In either case true is returned. Otherwise (the file
+//      could not be created or mapped, or is not in the format above)
+//      the mapped_sequence is closed and false is returned.
+//    Note: Only the header is read, so opening is O(1).
+//
+//   bool flush()
+//    Pre:  none
+//    Post: If the mapped_sequence is open, all changes so far have
+//      been written to the file on disk (not just to the page cache)
+//      before returning, and true is returned if that succeeded. If
+//      it is closed, true is returned.
+//
+//   void close()
+//    Pre:  none
+//    Post: The file (if any) has been unmapped and closed, and the
+//      mapped_sequence is closed. The changes are kept in the file,
+//      but may still be on their way to disk (see flush).
+//
+//   bool reserve(size_type min_capacity)
+//    Pre:  is_open() returns true.
+//    Post: If the file has room for at least min_capacity items, or
+//      could be grown to have it, true is returned; otherwise false
+//      is returned and the mapped_sequence is unchanged, except in
+//      the rare case that growing the mapping failed and the file
+//      could not be shrunk back either: then the file (still
+//      consistent, with some slack at its end) has been closed, and
+//      is_open() returns false.
+//
+//   void start()
+//   void advance()
+//    Same as for sequence (see Sequence.h).
+//
+//   bool insert(const value_type& entry)
+//   bool attach(const value_type& entry)
+//    Pre:  is_open() returns true.
+//    Post: Same as for sequence, and true is returned, unless the file
+//      was full and could not be grown; then false is returned and
+//      the mapped_sequence is unchanged (or closed; see reserve).
+//    Note: A full file is grown by half its capacity (plus 1) in
+//      place, with ftruncate and mremap; the items are not copied.
+//      Items after the current one are shifted in the file, so
+//      inserting costs O(size() - current index).
+//
+//   void remove_current()
+//    Pre:  is_open() and is_item() return true.
+//    Post: Same as for sequence (the file is not shrunk).
+//
+// CONSTANT MEMBER FUNCTIONS for the mapped_sequence class:
+//   bool is_open() const
+//    Pre:  none
+//    Post: True is returned if a file is open, otherwise false.
+//
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    Same as for sequence.
+//
+// NOTE: Changing the file by other means while it is open, or
+//   running out of disk space for pages the file was grown by, is
+//   not detected (the latter shows up as a SIGBUS when the page is
+//   first written). The header is updated along with the items, so
+//   a file that was flushed and closed is always consistent.
+//
+// VALUE SEMANTICS for the mapped_sequence class:
+//   Assignment and the copy constructor may NOT be used with
+//   mapped_sequence objects.
+
+#ifndef MAPPED_SEQUENCE_H
+#define MAPPED_SEQUENCE_H
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_FA2021
+{
+   class mapped_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 1024;
+      // CONSTRUCTOR and DESTRUCTOR
+      mapped_sequence();
+      ~mapped_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      bool open(const char* file_name,
+                size_type initial_capacity = DEFAULT_CAPACITY);
+      bool flush();
+      void close();
+      bool reserve(size_type min_capacity);
+      void start();
+      void advance();
+      bool insert(const value_type& entry);
+      bool attach(const value_type& entry);
+      void remove_current();
+      // CONSTANT MEMBER FUNCTIONS
+      bool is_open() const;
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      struct file_header
+      {
+         char magic[4];
+         unsigned int reserved;
+         unsigned long long used;
+         unsigned long long current_index;
+         unsigned long long capacity;
+      };
+      int fd;
+      void* mapping;
+      size_type mapped_length;
+      file_header* header;
+      value_type* data;
+      bool map(size_type capacity);
+      bool grow_if_full();
+      mapped_sequence(const mapped_sequence& source);
+      mapped_sequence& operator=(const mapped_sequence& source);
+   };
+}
+
+#endif
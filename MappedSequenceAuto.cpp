@@ -0,0 +1,419 @@
+// FILE: MappedSequenceAuto.cpp
+// A non-interactive test program for the mapped_sequence class.
+//
+// DESCRIPTION:
+// Each function of this program tests part of the mapped_sequence
+// class, returning some number of points to indicate how much of the
+// test was passed. The tests create, close and reopen sequence files
+// (in the current directory, removing them afterwards), and check that
+// open refuses files whose MSQ1 header is damaged.
+// A description and result of each test is printed to cout.
+// Maximum number of points awarded by this program is determined by the
+// constants POINTS[1], POINTS[2]...
+
+#include <iostream>          // provides cout.
+#include <fstream>           // provides ifstream and ofstream.
+#include <iterator>          // provides istreambuf_iterator.
+#include <cstdio>            // provides remove.
+#include <cstdlib>           // provides size_t.
+#include <cstring>           // provides memcpy.
+#include <string>            // provides string.
+#include "MappedSequence.h"  // provides the mapped_sequence class.
+using namespace std;
+using namespace CS3358_FA2021;
+
+// Descriptions and points for each of the tests:
+const size_t MANY_TESTS = 4;
+const int POINTS[MANY_TESTS+1] =
+{
+    12,  // Total points for all tests.
+     3,  // Test 1 points
+     3,  // Test 2 points
+     3,  // Test 3 points
+     3   // Test 4 points
+};
+const char DESCRIPTION[MANY_TESTS+1][256] =
+{
+    "tests for mapped_sequence class",
+    "Testing open on a new file, close and reopen",
+    "Testing reopen after the file has grown and after removals",
+    "Testing that open refuses files with a bad MSQ1 header",
+    "Testing reserve that fails and the closed mapped_sequence"
+};
+
+const char FILE_NAME[] = "MappedSequenceAuto.msq";
+
+// The file header, as laid out in MappedSequence.h.
+struct header
+{
+    char magic[4];
+    unsigned int reserved;
+    unsigned long long used;
+    unsigned long long current_index;
+    unsigned long long capacity;
+};
+
+
+// **************************************************************************
+// bool correct(mapped_sequence& test, size_t s, size_t cursor_spot,
+//              const double items[])
+//   Postcondition: A return value of true indicates that test is open,
+//   has s items, equal to items[0] ... items[s-1], and its current item
+//   is item [cursor_spot] (no current item if cursor_spot >= s).
+//   Otherwise the return value is false. In either case, a description
+//   of the test result is printed to cout.
+//   NOTE: The items are checked by walking the cursor, which is put
+//   back on item [cursor_spot] (or off the sequence) afterwards.
+// **************************************************************************
+bool correct(mapped_sequence& test, size_t s, size_t cursor_spot,
+             const double items[])
+{
+    cout << "Checking that the sequence is open with " << s << " items\n";
+    cout << "and the cursor at item [" << cursor_spot << "]...";
+    cout.flush();
+    bool answer = test.is_open() && test.size() == s
+                  && test.is_item() == (cursor_spot < s)
+                  && (cursor_spot >= s || test.current() == items[cursor_spot]);
+    size_t i = 0;
+    for (test.start(); answer && i < s; ++i, test.advance())
+        answer = test.is_item() && test.current() == items[i];
+    answer = answer && !test.is_item();
+
+    // put the cursor back
+    test.start();
+    for (i = 0; i < cursor_spot && i < s; ++i)
+        test.advance();
+    if (cursor_spot >= s)
+        while (test.is_item())
+            test.advance();
+
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    return answer;
+}
+
+// Writes a file holding h followed by capacity items (all 0), or just
+// the first length bytes of that if length is given.
+void write_file(const header& h, size_t capacity, size_t length = 0)
+{
+    string bytes(sizeof h + capacity * sizeof(double), '\0');
+    memcpy(&bytes[0], &h, sizeof h);
+    if (length == 0 || length > bytes.size())
+        length = bytes.size();
+    ofstream out(FILE_NAME, ios::binary | ios::trunc);
+    out.write(bytes.data(), length);
+}
+
+// Returns the contents of the file (empty if there is none).
+string read_file()
+{
+    ifstream in(FILE_NAME, ios::binary);
+    return string((istreambuf_iterator<char>(in)),
+                  istreambuf_iterator<char>());
+}
+
+// A header of a valid file with the given fields.
+header valid_header(unsigned long long used, unsigned long long current_index,
+                    unsigned long long capacity)
+{
+    header h;
+    memcpy(h.magic, "MSQ1", 4);
+    h.reserved = 0;
+    h.used = used;
+    h.current_index = current_index;
+    h.capacity = capacity;
+    return h;
+}
+
+
+// **************************************************************************
+// int test1()
+//   Creates a sequence file, fills it, closes it and opens it again.
+//   Returns POINTS[1] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test1()
+{
+    const double items[] = { 1.5, 2.5, 3.5, 4.5, 5.5 };
+    remove(FILE_NAME);
+    {
+        mapped_sequence test;
+        cout << "Opening a new file with room for 8 items...";
+        cout.flush();
+        bool answer = test.open(FILE_NAME, 8) && test.is_open()
+                      && test.size() == 0 && !test.is_item();
+        cout << (answer ? "Passed." : "Failed.") << endl;
+        if (!answer)
+            return 0;
+        cout << "Checking the size of the file...";
+        cout.flush();
+        answer = read_file().size() == sizeof(header) + 8 * sizeof(double);
+        cout << (answer ? "Passed." : "Failed.") << endl;
+        if (!answer)
+            return 0;
+
+        for (size_t i = 0; i < 5; ++i)
+            test.attach(items[i]);
+        test.start();
+        test.advance();
+        test.advance();
+        if (!correct(test, 5, 2, items))
+            return 0;
+        cout << "Flushing and closing...";
+        cout.flush();
+        answer = test.flush();
+        test.close();
+        answer = answer && !test.is_open() && test.size() == 0
+                 && !test.is_item() && test.flush();
+        cout << (answer ? "Passed." : "Failed.") << endl;
+        if (!answer)
+            return 0;
+
+        cout << "Reopening the file (the capacity argument is ignored)...";
+        cout.flush();
+        answer = test.open(FILE_NAME, 1);
+        cout << (answer ? "Passed." : "Failed.") << endl;
+        if (!answer || !correct(test, 5, 2, items))
+            return 0;
+        // the destructor closes the file
+    }
+
+    mapped_sequence test;
+    cout << "Reopening the file after the destructor closed it...";
+    cout.flush();
+    bool answer = test.open(FILE_NAME);
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    if (!answer || !correct(test, 5, 2, items))
+        return 0;
+    test.close();
+    remove(FILE_NAME);
+
+    cout << "All tests of this first function have been passed." << endl;
+    return POINTS[1];
+}
+
+
+// **************************************************************************
+// int test2()
+//   Grows a sequence file past its capacity (through attach and
+//   reserve), removes items, and checks each state after reopening.
+//   Returns POINTS[2] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test2()
+{
+    const size_t MANY = 100;
+    double items[MANY];
+    remove(FILE_NAME);
+
+    mapped_sequence test;
+    if (!test.open(FILE_NAME, 1))
+        return 0;
+    cout << "Attaching " << MANY << " items to a file with room for 1...";
+    cout.flush();
+    bool answer = true;
+    for (size_t i = 0; answer && i < MANY; ++i)
+    {
+        items[i] = i * 0.25;
+        answer = test.attach(items[i]);
+    }
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    if (!answer || !correct(test, MANY, MANY - 1, items))
+        return 0;
+
+    test.close();
+    if (!test.open(FILE_NAME) || !correct(test, MANY, MANY - 1, items))
+        return 0;
+
+    cout << "Reserving room for 1000 items, then reopening...";
+    cout.flush();
+    answer = test.reserve(1000);
+    test.close();
+    answer = answer
+             && read_file().size() == sizeof(header) + 1000 * sizeof(double)
+             && test.open(FILE_NAME);
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    if (!answer || !correct(test, MANY, MANY - 1, items))
+        return 0;
+
+    // remove the first half, leaving the cursor off the sequence
+    test.start();
+    for (size_t i = 0; i < MANY / 2; ++i)
+        test.remove_current();
+    while (test.is_item())
+        test.advance();
+    test.close();
+    cout << "Reopening after removing the first " << MANY / 2 << " items...";
+    cout.flush();
+    answer = test.open(FILE_NAME);
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    if (!answer || !correct(test, MANY / 2, MANY / 2, items + MANY / 2))
+        return 0;
+    test.close();
+    remove(FILE_NAME);
+
+    cout << "All tests of this second function have been passed." << endl;
+    return POINTS[2];
+}
+
+
+// **************************************************************************
+// int test3()
+//   Writes sequence files with damaged headers and checks that open
+//   returns false, leaves the mapped_sequence closed and leaves the
+//   file as it was; then checks that an intact hand-made file opens.
+//   Returns POINTS[3] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test3()
+{
+    struct bad_file
+    {
+        const char* what;
+        header h;
+        size_t capacity;   // # of item slots actually written
+        size_t length;     // bytes written (0 for all of them)
+    };
+    header wrong_magic = valid_header(2, 0, 4);
+    memcpy(wrong_magic.magic, "MSQ2", 4);
+    const bad_file BAD[] =
+    {
+        { "a wrong magic",                    wrong_magic,              4, 0 },
+        { "a header cut short",               valid_header(2, 0, 4),    4, 20 },
+        { "a capacity of 0",                  valid_header(0, 0, 0),    4, 0 },
+        { "a capacity past the end of file",  valid_header(2, 0, 5),    4, 0 },
+        { "more items than the capacity",     valid_header(5, 0, 4),    4, 0 },
+        { "a current index past the items",   valid_header(2, 3, 4),    4, 0 },
+        { "a huge capacity",
+          valid_header(2, 0, 1ull << 61),                               4, 0 }
+    };
+
+    for (size_t k = 0; k < sizeof BAD / sizeof BAD[0]; ++k)
+    {
+        write_file(BAD[k].h, BAD[k].capacity, BAD[k].length);
+        string before = read_file();
+        mapped_sequence test;
+        cout << "Opening a file with " << BAD[k].what << "...";
+        cout.flush();
+        bool answer = !test.open(FILE_NAME) && !test.is_open()
+                      && test.size() == 0 && !test.is_item()
+                      && read_file() == before;
+        cout << (answer ? "Passed." : "Failed.") << endl;
+        if (!answer)
+            return 0;
+    }
+
+    // the same file, with the header intact (and slack at the end)
+    write_file(valid_header(2, 1, 4), 6);
+    mapped_sequence test;
+    cout << "Opening a hand-made file with an intact header...";
+    cout.flush();
+    bool answer = test.open(FILE_NAME);
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    const double zeros[] = { 0.0, 0.0 };
+    if (!answer || !correct(test, 2, 1, zeros))
+        return 0;
+    test.close();
+    remove(FILE_NAME);
+
+    cout << "All tests of this third function have been passed." << endl;
+    return POINTS[3];
+}
+
+
+// **************************************************************************
+// int test4()
+//   Asks for capacities that can't be had, and checks that reserve
+//   returns false with the sequence unchanged; then checks that a
+//   mapped_sequence that was never opened behaves as an empty one.
+//   Returns POINTS[4] if the tests pass. Otherwise returns 0.
+// **************************************************************************
+int test4()
+{
+    const double items[] = { 7.0, 8.0, 9.0 };
+    const mapped_sequence::size_type TOO_MANY[] =
+    {
+        mapped_sequence::size_type(1) << 60,    // bytes overflow off_t
+        mapped_sequence::size_type(-1) / 8      // bytes wrap around
+    };
+    remove(FILE_NAME);
+
+    mapped_sequence test;
+    if (!test.open(FILE_NAME, 3))
+        return 0;
+    for (size_t i = 0; i < 3; ++i)
+        test.attach(items[i]);
+    test.start();
+    string before = read_file();
+
+    for (size_t k = 0; k < sizeof TOO_MANY / sizeof TOO_MANY[0]; ++k)
+    {
+        cout << "Reserving room for " << TOO_MANY[k] << " items...";
+        cout.flush();
+        bool answer = !test.reserve(TOO_MANY[k]) && read_file() == before;
+        cout << (answer ? "Passed." : "Failed.") << endl;
+        if (!answer || !correct(test, 3, 0, items))
+            return 0;
+    }
+    test.close();
+    remove(FILE_NAME);
+
+    mapped_sequence closed;
+    cout << "Checking a mapped_sequence that was never opened...";
+    cout.flush();
+    closed.start();
+    closed.advance();
+    bool answer = !closed.is_open() && closed.size() == 0
+                  && !closed.is_item() && closed.flush();
+    closed.close();
+    answer = answer && !closed.is_open();
+    cout << (answer ? "Passed." : "Failed.") << endl;
+    if (!answer)
+        return 0;
+
+    cout << "All tests of this fourth function have been passed." << endl;
+    return POINTS[4];
+}
+
+
+int run_a_test(int number, const char message[], int test_function(), int max)
+{
+    int result;
+
+    cout << endl << "START OF TEST " << number << ":" << endl;
+    cout << message << " (" << max << " points)." << endl;
+    result = test_function();
+    if (result > 0)
+    {
+        cout << "Test " << number << " got " << result << " points";
+        cout << " out of a possible " << max << "." << endl;
+    }
+    else
+        cout << "Test " << number << " failed." << endl;
+    cout << "END OF TEST " << number << "." << endl << endl;
+
+    return result;
+}
+
+
+// **************************************************************************
+// int main()
+//   The main program calls all tests and prints the sum of all points
+//   earned from the tests.
+// **************************************************************************
+int main()
+{
+    int sum = 0;
+
+
+    cout << "Running " << DESCRIPTION[0] << endl;
+
+    sum += run_a_test(1, DESCRIPTION[1], test1, POINTS[1]);
+    sum += run_a_test(2, DESCRIPTION[2], test2, POINTS[2]);
+    sum += run_a_test(3, DESCRIPTION[3], test3, POINTS[3]);
+    sum += run_a_test(4, DESCRIPTION[4], test4, POINTS[4]);
+    remove(FILE_NAME);
+
+    cout << "Your mapped_sequence implementation has scored\n";
+    cout << sum << " points out of the " << POINTS[0];
+    cout << " points based on this test program.\n";
+
+    return EXIT_SUCCESS;
+
+}
@@ -3,17 +3,47 @@
 // INVARIANT for the sequence ADT:
 //   1. The number of items in the sequence is in the member variable
 //      used;
-//   2. The actual items of the sequence are stored in a partially
-//      filled array. The array is a dynamic array, pointed to by
-//      the member variable data. For an empty sequence, we do not
-//      care what is stored in any of data; for a non-empty sequence
-//      the items in the sequence are stored in data[0] through
-//      data[used-1], and we don't care what's in the rest of data.
+//   2. The actual items of the sequence are stored in a gap buffer:
+//      a dynamic array, pointed to by the member variable data, in
+//      which the free space (the "gap") sits between the items. The
+//      member variable tail is the number of items after the gap,
+//      so the gap starts at gap_start() == used - tail. Items 0
+//      through gap_start()-1 are stored in data[0] through
+//      data[gap_start()-1], and the remaining tail items are stored
+//      at the end of the array, in data[capacity-tail] through
+//      data[capacity-1]. We don't care what's in the gap.
+//      0 <= tail <= used.
+//      NOTE: The gap is moved (lazily) to where an item is inserted
+//            or removed, so a run of insert/attach/remove_current
+//            calls around the current item shifts no more than the
+//            distance the cursor moved since the previous edit,
+//            instead of the whole tail of the sequence.
+//      NOTE: Keeping tail rather than the gap's position means that
+//            filling the gap (the usual case, appending at the end)
+//            changes used alone.
 //   3. The size of the dynamic array is in the member variable
-//      capacity.
-//   4. The index of the current item is in the member variable
-//      current_index. If there is no valid current item, then
-//      current_index will be set to the same number as used.
+//      capacity. A sequence that has been moved from has no array
+//      (data and refs are 0 and capacity is 0) until it grows again.
+//   4. The dynamic array may be shared by copies of the sequence
+//      (copy-on-write): *refs counts the sequences whose data points
+//      to it, and the array is freed when the last of them lets go.
+//      While *refs > 1 the array and the gap are read-only; every
+//      function that changes the items or moves the gap calls
+//      unshare first. Since a shared array never changes, the copies
+//      each keep their own used, capacity and gap_start, which stay
+//      equal until one of them is modified.
+//      NOTE: Once the non-const begin or end has handed out an
+//            iterator that can write to the array, shareable is false
+//            and copies of the sequence get their own array right
+//            away (as std::string did under copy-on-write); otherwise
+//            a copy made later would share the array, and writes
+//            through the iterator would change both. shareable is
+//            true again when the array is replaced (resize or
+//            assignment), since that invalidates the iterators.
+//   5. The index of the current item is in the member variable
+//      current_index (which is never shared). If there is no valid
+//      current item, then current_index will be set to the same
+//      number as used.
 //      NOTE: Setting current_index to be the same as used to
 //            indicate "no current item exists" is a good choice
 //            for at least the following reasons:
@@ -37,122 +67,1038 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//   6. cursors heads a doubly linked list (through cursor::prev and
+//      cursor::next) of the cursors bound to the sequence. Each
+//      cursor's index follows the same rule as current_index (== used
+//      means no current item); every function that inserts, removes
+//      or replaces items updates them all, along with current_index.
+//   7. If recording is true, every insertion or removal of items is
+//      appended to history as one edit per item, in the order a
+//      one-item-at-a-time version of the operation would make them.
+//      history[0] through history[applied-1] have been made (undo
+//      replays their inverses from the end); history[applied] onward
+//      were undone and can be redone. An undo step is a run of edits
+//      from one with starts_step set up to the next such edit;
+//      step_open is true once the current step has its first edit.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   size_type gap_start() const
+//    Pre:  none
+//    Post: The index of the first item after the gap (used if there
+//      is none) is returned; the gap sits just before it.
+//
+//   size_type physical(size_type index) const
+//    Pre:  index < used
+//    Post: The position in data of the item at index is returned.
+//
+//   value_type* after_gap() const
+//    Pre:  none
+//    Post: A pointer to the first position in data after the gap is
+//      returned; items gap_start through used-1 are stored from there
+//      to the end of data.
+//
+//   void grow_if_full()
+//    Pre:  none
+//    Post: If used == capacity, the capacity has been grown by the
+//      member variable growth_factor (see set_growth_factor).
+//
+//   value_type* make_room(size_type position, size_type count)
+//    Pre:  position <= used
+//    Post: Room for count new items has been made before the item at
+//      position (growing the capacity at most once and moving the gap
+//      there), used has been increased by count, and a pointer to the
+//      first of the count slots is returned. The caller must store
+//      the new items there right away.
+//
+//   void unshare()
+//    Pre:  none
+//    Post: The sequence is the only one using its dynamic array (if it
+//      shared the array, it now has its own copy with the same
+//      capacity and gap position).
+//
+//   void release()
+//    Pre:  none
+//    Post: The sequence no longer uses its dynamic array (data and refs
+//      are 0), and the array has been freed if no other sequence uses
+//      it. The caller must set up data, refs and capacity again.
+//
+//   void put(size_type position, const value_type& entry)
+//    Pre:  position <= used
+//    Post: entry has been inserted before the item at position (at
+//      the end if position == used), growing the array if it was full,
+//      and the current item and cursors have been adjusted (see
+//      items_inserted); the caller decides what becomes current.
+//
+//   void items_inserted(size_type position, size_type count)
+//   void items_removed(size_type first, size_type last)
+//   void items_replaced()
+//    Pre:  The items have just been changed as the name says (count
+//      items inserted before the item that was at position, or the
+//      items first through last-1 removed, or all of them replaced).
+//    Post: current_index and the index of every bound cursor have been
+//      adjusted, so they refer to the same items as before; a removed
+//      item's position passes to the item after it. After a
+//      replacement every cursor has no current item and the edit
+//      history has been cleared.
+//
+//   vector<size_type*> positions_in_order()
+//    Pre:  none
+//    Post: Pointers to current_index and to the index of every bound
+//      cursor are returned, ordered by the index they point to (for
+//      functions that renumber all items in one pass).
+//
+//   void record(bool inserted, size_type position,
+//               const value_type& item, size_type current_before)
+//    Pre:  item has just been (or is about to be) inserted at, or
+//      removed from, position; current_before is current_index before
+//      the edit this is part of.
+//    Post: If edits are being recorded, the edit has been appended to
+//      history (see EDIT HISTORY in Sequence.h), discarding any edits
+//      that could have been redone; otherwise nothing has changed.
+//
+//   void record_inserted(size_type position, size_type count,
+//                        size_type current_before)
+//    Pre:  make_room(position, count) has just been called and the
+//      count new items stored.
+//    Post: Their insertion has been recorded, one item at a time.
+//
+//   value_type* make_contiguous()
+//    Pre:  none
+//    Post: The array is not shared and the gap has been moved to its
+//      end, so the items are stored in data[0] through data[used-1];
+//      data is returned.
+//
+//   void move_gap(size_type position)
+//    Pre:  position <= used
+//    Post: The gap has been moved so that gap_start() == position; the
+//      items and their order are unchanged. Costs O(distance moved).
+//    Note: The array must not be shared (call unshare first).
 
 #include <cassert>
+#include <cmath>
 #include "Sequence.h"
 #include <iostream>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
 using namespace std;
 
+#if defined(__GNUC__) && defined(__SSE2__) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define SEQUENCE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// Kernels for the numeric member functions, each over a plain array
+// p[0] .. p[n-1] (the sequence calls them once per side of its gap).
+// On x86 each has an SSE2 version (always there on x86-64) and an
+// AVX2 version that is picked at run time if the CPU supports it;
+// elsewhere the plain loops are used.
+namespace
+{
+   // adds x into the running total sum + comp (Neumaier's variant of
+   // Kahan summation, which also copes with x larger than sum)
+   void compensated_add(double& sum, double& comp, double x)
+   {
+      double t = sum + x;
+      if (fabs(sum) >= fabs(x))
+         comp += (sum - t) + x;
+      else
+         comp += (x - t) + sum;
+      sum = t;
+   }
+
+#ifdef SEQUENCE_X86_SIMD
+   bool has_avx2()
+   {
+      static const bool yes = __builtin_cpu_supports("avx2");
+      return yes;
+   }
+
+   double lane_sum(__m128d v)
+   {
+      double lane[2];
+      _mm_storeu_pd(lane, v);
+      return lane[0] + lane[1];
+   }
+
+   __attribute__((target("avx2")))
+   double lane_sum(__m256d v)
+   {
+      return lane_sum(_mm_add_pd(_mm256_castpd256_pd128(v),
+                                 _mm256_extractf128_pd(v, 1)));
+   }
+
+   double sum_sse2(const double* p, size_t n)
+   {
+      __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+         a0 = _mm_add_pd(a0, _mm_loadu_pd(p + i));
+         a1 = _mm_add_pd(a1, _mm_loadu_pd(p + i + 2));
+      }
+      double s = lane_sum(_mm_add_pd(a0, a1));
+      for (; i < n; ++i)
+         s += p[i];
+      return s;
+   }
+
+   __attribute__((target("avx2")))
+   double sum_avx2(const double* p, size_t n)
+   {
+      __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+      size_t i = 0;
+      for (; i + 8 <= n; i += 8)
+      {
+         a0 = _mm256_add_pd(a0, _mm256_loadu_pd(p + i));
+         a1 = _mm256_add_pd(a1, _mm256_loadu_pd(p + i + 4));
+      }
+      double s = lane_sum(_mm256_add_pd(a0, a1));
+      for (; i < n; ++i)
+         s += p[i];
+      return s;
+   }
+
+   // each lane keeps its own Kahan sum; the lanes are folded into
+   // sum + comp at the end
+   void kahan_sse2(const double* p, size_t n, double& sum, double& comp)
+   {
+      __m128d s = _mm_setzero_pd(), c = _mm_setzero_pd();
+      size_t i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+         __m128d y = _mm_sub_pd(_mm_loadu_pd(p + i), c);
+         __m128d t = _mm_add_pd(s, y);
+         c = _mm_sub_pd(_mm_sub_pd(t, s), y);
+         s = t;
+      }
+      double lane_s[2], lane_c[2];
+      _mm_storeu_pd(lane_s, s);
+      _mm_storeu_pd(lane_c, c);
+      for (int k = 0; k < 2; ++k)
+      {
+         compensated_add(sum, comp, lane_s[k]);
+         compensated_add(sum, comp, -lane_c[k]);
+      }
+      for (; i < n; ++i)
+         compensated_add(sum, comp, p[i]);
+   }
+
+   __attribute__((target("avx2")))
+   void kahan_avx2(const double* p, size_t n, double& sum, double& comp)
+   {
+      __m256d s = _mm256_setzero_pd(), c = _mm256_setzero_pd();
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+         __m256d y = _mm256_sub_pd(_mm256_loadu_pd(p + i), c);
+         __m256d t = _mm256_add_pd(s, y);
+         c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+         s = t;
+      }
+      double lane_s[4], lane_c[4];
+      _mm256_storeu_pd(lane_s, s);
+      _mm256_storeu_pd(lane_c, c);
+      for (int k = 0; k < 4; ++k)
+      {
+         compensated_add(sum, comp, lane_s[k]);
+         compensated_add(sum, comp, -lane_c[k]);
+      }
+      for (; i < n; ++i)
+         compensated_add(sum, comp, p[i]);
+   }
+
+   double dot_sse2(const double* p, const double* q, size_t n)
+   {
+      __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+         a0 = _mm_add_pd(a0, _mm_mul_pd(_mm_loadu_pd(p + i),
+                                        _mm_loadu_pd(q + i)));
+         a1 = _mm_add_pd(a1, _mm_mul_pd(_mm_loadu_pd(p + i + 2),
+                                        _mm_loadu_pd(q + i + 2)));
+      }
+      double s = lane_sum(_mm_add_pd(a0, a1));
+      for (; i < n; ++i)
+         s += p[i] * q[i];
+      return s;
+   }
+
+   __attribute__((target("avx2")))
+   double dot_avx2(const double* p, const double* q, size_t n)
+   {
+      __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+      size_t i = 0;
+      for (; i + 8 <= n; i += 8)
+      {
+         a0 = _mm256_add_pd(a0, _mm256_mul_pd(_mm256_loadu_pd(p + i),
+                                              _mm256_loadu_pd(q + i)));
+         a1 = _mm256_add_pd(a1, _mm256_mul_pd(_mm256_loadu_pd(p + i + 4),
+                                              _mm256_loadu_pd(q + i + 4)));
+      }
+      double s = lane_sum(_mm256_add_pd(a0, a1));
+      for (; i < n; ++i)
+         s += p[i] * q[i];
+      return s;
+   }
+
+   double squared_deviation_sse2(const double* p, size_t n, double mean)
+   {
+      __m128d m = _mm_set1_pd(mean), a = _mm_setzero_pd();
+      size_t i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+         __m128d d = _mm_sub_pd(_mm_loadu_pd(p + i), m);
+         a = _mm_add_pd(a, _mm_mul_pd(d, d));
+      }
+      double s = lane_sum(a);
+      for (; i < n; ++i)
+         s += (p[i] - mean) * (p[i] - mean);
+      return s;
+   }
+
+   __attribute__((target("avx2")))
+   double squared_deviation_avx2(const double* p, size_t n, double mean)
+   {
+      __m256d m = _mm256_set1_pd(mean), a = _mm256_setzero_pd();
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+         __m256d d = _mm256_sub_pd(_mm256_loadu_pd(p + i), m);
+         a = _mm256_add_pd(a, _mm256_mul_pd(d, d));
+      }
+      double s = lane_sum(a);
+      for (; i < n; ++i)
+         s += (p[i] - mean) * (p[i] - mean);
+      return s;
+   }
+
+   // least (or, if largest is true, greatest) of start and p[0..n-1]
+   double extreme_sse2(const double* p, size_t n, double start, bool largest)
+   {
+      __m128d e = _mm_set1_pd(start);
+      size_t i = 0;
+      if (largest)
+         for (; i + 2 <= n; i += 2)
+            e = _mm_max_pd(e, _mm_loadu_pd(p + i));
+      else
+         for (; i + 2 <= n; i += 2)
+            e = _mm_min_pd(e, _mm_loadu_pd(p + i));
+      double lane[2];
+      _mm_storeu_pd(lane, e);
+      double x = largest ? (lane[0] > lane[1] ? lane[0] : lane[1])
+                         : (lane[0] < lane[1] ? lane[0] : lane[1]);
+      for (; i < n; ++i)
+         if (largest ? p[i] > x : p[i] < x)
+            x = p[i];
+      return x;
+   }
+
+   __attribute__((target("avx2")))
+   double extreme_avx2(const double* p, size_t n, double start, bool largest)
+   {
+      __m256d e = _mm256_set1_pd(start);
+      size_t i = 0;
+      if (largest)
+         for (; i + 4 <= n; i += 4)
+            e = _mm256_max_pd(e, _mm256_loadu_pd(p + i));
+      else
+         for (; i + 4 <= n; i += 4)
+            e = _mm256_min_pd(e, _mm256_loadu_pd(p + i));
+      double lane[4];
+      _mm256_storeu_pd(lane, e);
+      double x = lane[0];
+      for (int k = 1; k < 4; ++k)
+         if (largest ? lane[k] > x : lane[k] < x)
+            x = lane[k];
+      for (; i < n; ++i)
+         if (largest ? p[i] > x : p[i] < x)
+            x = p[i];
+      return x;
+   }
+
+   // p[i] = p[i] * factor if multiply is true, else p[i] + factor
+   void apply_sse2(double* p, size_t n, double factor, bool multiply)
+   {
+      __m128d f = _mm_set1_pd(factor);
+      size_t i = 0;
+      if (multiply)
+         for (; i + 2 <= n; i += 2)
+            _mm_storeu_pd(p + i, _mm_mul_pd(_mm_loadu_pd(p + i), f));
+      else
+         for (; i + 2 <= n; i += 2)
+            _mm_storeu_pd(p + i, _mm_add_pd(_mm_loadu_pd(p + i), f));
+      for (; i < n; ++i)
+         p[i] = multiply ? p[i] * factor : p[i] + factor;
+   }
+
+   __attribute__((target("avx2")))
+   void apply_avx2(double* p, size_t n, double factor, bool multiply)
+   {
+      __m256d f = _mm256_set1_pd(factor);
+      size_t i = 0;
+      if (multiply)
+         for (; i + 4 <= n; i += 4)
+            _mm256_storeu_pd(p + i, _mm256_mul_pd(_mm256_loadu_pd(p + i), f));
+      else
+         for (; i + 4 <= n; i += 4)
+            _mm256_storeu_pd(p + i, _mm256_add_pd(_mm256_loadu_pd(p + i), f));
+      for (; i < n; ++i)
+         p[i] = multiply ? p[i] * factor : p[i] + factor;
+   }
+#endif
+
+   double sum_of(const double* p, size_t n)
+   {
+#ifdef SEQUENCE_X86_SIMD
+      return has_avx2() ? sum_avx2(p, n) : sum_sse2(p, n);
+#else
+      double s0 = 0, s1 = 0;
+      size_t i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+         s0 += p[i];
+         s1 += p[i + 1];
+      }
+      for (; i < n; ++i)
+         s0 += p[i];
+      return s0 + s1;
+#endif
+   }
+
+   void kahan_sum_of(const double* p, size_t n, double& sum, double& comp)
+   {
+#ifdef SEQUENCE_X86_SIMD
+      if (has_avx2())
+         kahan_avx2(p, n, sum, comp);
+      else
+         kahan_sse2(p, n, sum, comp);
+#else
+      for (size_t i = 0; i < n; ++i)
+         compensated_add(sum, comp, p[i]);
+#endif
+   }
+
+   double dot_of(const double* p, const double* q, size_t n)
+   {
+#ifdef SEQUENCE_X86_SIMD
+      return has_avx2() ? dot_avx2(p, q, n) : dot_sse2(p, q, n);
+#else
+      double s = 0;
+      for (size_t i = 0; i < n; ++i)
+         s += p[i] * q[i];
+      return s;
+#endif
+   }
+
+   double squared_deviation_of(const double* p, size_t n, double mean)
+   {
+#ifdef SEQUENCE_X86_SIMD
+      return has_avx2() ? squared_deviation_avx2(p, n, mean)
+                        : squared_deviation_sse2(p, n, mean);
+#else
+      double s = 0;
+      for (size_t i = 0; i < n; ++i)
+         s += (p[i] - mean) * (p[i] - mean);
+      return s;
+#endif
+   }
+
+   double extreme_of(const double* p, size_t n, double start, bool largest)
+   {
+#ifdef SEQUENCE_X86_SIMD
+      return has_avx2() ? extreme_avx2(p, n, start, largest)
+                        : extreme_sse2(p, n, start, largest);
+#else
+      for (size_t i = 0; i < n; ++i)
+         if (largest ? p[i] > start : p[i] < start)
+            start = p[i];
+      return start;
+#endif
+   }
+
+   // Parallel merge sort for sequence::sort and stable_sort: the items
+   // are cut into one run per thread, the runs are sorted at the same
+   // time, and then merged pairwise in rounds through a scratch array.
+   // Each merge of a round is itself split into pieces of equal output
+   // size (see co_rank), so all threads stay busy in the last rounds
+   // too, when there are fewer pairs of runs than threads.
+
+   // runs shorter than this aren't worth a thread of their own
+   const size_t MIN_ITEMS_PER_THREAD = size_t(1) << 16;
+
+   int resolve_thread_count(int thread_count)
+   {
+      if (thread_count > 0)
+         return thread_count;
+      int hardware = int(thread::hardware_concurrency());
+      return hardware > 0 ? hardware : 1;
+   }
+
+   // the number of items of a[0..m-1] among the first k items of the
+   // stable merge of a[0..m-1] and b[0..n-1] (ties are taken from a)
+   size_t co_rank(size_t k, const double* a, size_t m,
+                  const double* b, size_t n)
+   {
+      size_t lo = k > n ? k - n : 0, hi = k < m ? k : m;
+      while (lo < hi)
+      {
+         size_t i = lo + (hi - lo) / 2;
+         if (!(b[k - i - 1] < a[i]))  // a[i] comes before b[k - i - 1]
+            lo = i + 1;
+         else
+            hi = i;
+      }
+      return lo;
+   }
+
+   void merge_piece(const double* a, size_t m, const double* b, size_t n,
+                    double* out, size_t first, size_t last)
+   {
+      size_t i0 = co_rank(first, a, m, b, n), i1 = co_rank(last, a, m, b, n);
+      merge(a + i0, a + i1, b + (first - i0), b + (last - i1), out + first);
+   }
+
+   void parallel_sort(double* items, size_t n, int thread_count, bool stable)
+   {
+      int threads = resolve_thread_count(thread_count);
+      if (size_t(threads) > n / MIN_ITEMS_PER_THREAD)
+         threads = n / MIN_ITEMS_PER_THREAD > 0
+                   ? int(n / MIN_ITEMS_PER_THREAD) : 1;
+      if (threads == 1)
+      {
+         if (stable)
+            std::stable_sort(items, items + n);
+         else
+            std::sort(items, items + n);
+         return;
+      }
+
+      vector<size_t> bound(threads + 1);
+      for (int r = 0; r <= threads; ++r)
+         bound[r] = n * r / threads;
+      vector<thread> workers;
+      for (int r = 0; r < threads; ++r)
+         workers.push_back(thread([&, r]()
+         {
+            if (stable)
+               std::stable_sort(items + bound[r], items + bound[r + 1]);
+            else
+               std::sort(items + bound[r], items + bound[r + 1]);
+         }));
+      for (int r = 0; r < threads; ++r)
+         workers[r].join();
+
+      vector<double> scratch(n);
+      double* from = items;
+      double* to = &scratch[0];
+      while (bound.size() > 2)
+      {
+         size_t runs = bound.size() - 1, pairs = runs / 2;
+         size_t pieces = threads / pairs > 0 ? threads / pairs : 1;
+         workers.clear();
+         for (size_t p = 0; p < pairs; ++p)
+         {
+            size_t first = bound[2 * p], middle = bound[2 * p + 1],
+                   last = bound[2 * p + 2];
+            for (size_t k = 0; k < pieces; ++k)
+               workers.push_back(thread([=]()
+               {
+                  merge_piece(from + first, middle - first,
+                              from + middle, last - middle, to + first,
+                              (last - first) * k / pieces,
+                              (last - first) * (k + 1) / pieces);
+               }));
+         }
+         if (runs % 2 == 1)   // the odd run out just moves over
+            copy(from + bound[runs - 1], from + n, to + bound[runs - 1]);
+         for (size_t w = 0; w < workers.size(); ++w)
+            workers[w].join();
+
+         vector<size_t> merged;
+         for (size_t r = 0; r < runs; r += 2)
+            merged.push_back(bound[r]);
+         merged.push_back(n);
+         bound.swap(merged);
+         swap(from, to);
+      }
+      if (from != items)
+         copy(from, from + n, items);
+   }
+
+   // Binary I/O (write_binary and read_binary)
+
+   const size_t BINARY_HEADER_SIZE = 24;
+   const size_t IO_CHUNK_ITEMS = size_t(1) << 17;   // 1 MB of doubles
+
+   bool host_is_little_endian()
+   {
+      const unsigned int probe = 1;
+      return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+   }
+
+   void put_le(unsigned char* dest, unsigned long long value, int bytes)
+   {
+      for (int i = 0; i < bytes; ++i)
+         dest[i] = static_cast<unsigned char>(value >> (8 * i));
+   }
+
+   unsigned long long get_le(const unsigned char* src, int bytes)
+   {
+      unsigned long long value = 0;
+      for (int i = bytes - 1; i >= 0; --i)
+         value = (value << 8) | src[i];
+      return value;
+   }
+
+   // reverses the bytes of each of the n doubles at p (on big-endian
+   // hosts, to turn them into the little-endian file format and back)
+   void swap_bytes(double* p, size_t n)
+   {
+      for (size_t i = 0; i < n; ++i)
+      {
+         unsigned char* b = reinterpret_cast<unsigned char*>(p + i);
+         reverse(b, b + sizeof(double));
+      }
+   }
+
+   // CRC-32 with zlib's polynomial, eight bytes per step ("slicing by
+   // 8") so it keeps up with the disk
+   struct crc32_tables
+   {
+      unsigned int t[8][256];
+      crc32_tables()
+      {
+         for (unsigned int i = 0; i < 256; ++i)
+         {
+            unsigned int c = i;
+            for (int k = 0; k < 8; ++k)
+               c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[0][i] = c;
+         }
+         for (unsigned int i = 0; i < 256; ++i)
+            for (int k = 1; k < 8; ++k)
+               t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+      }
+   };
+
+   // the CRC-32 of the bytes whose CRC-32 was crc, followed by p[0..n-1]
+   unsigned int crc32_update(unsigned int crc, const unsigned char* p,
+                             size_t n)
+   {
+      static const crc32_tables tables;
+      const unsigned int (*t)[256] = tables.t;
+      unsigned int c = ~crc;
+      for (; n >= 8; p += 8, n -= 8)
+      {
+         unsigned int lo = c ^ (p[0] | (p[1] << 8) | (p[2] << 16)
+                                | (unsigned(p[3]) << 24));
+         unsigned int hi = p[4] | (p[5] << 8) | (p[6] << 16)
+                           | (unsigned(p[7]) << 24);
+         c = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF]
+             ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+             ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF]
+             ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+      }
+      for (; n > 0; ++p, --n)
+         c = t[0][(c ^ *p) & 0xFF] ^ (c >> 8);
+      return ~c;
+   }
+
+   // the n doubles at p in file byte order: p itself on little-endian
+   // hosts, otherwise a swapped copy in buffer
+   const char* file_bytes(const double* p, size_t n, vector<double>& buffer)
+   {
+      if (host_is_little_endian())
+         return reinterpret_cast<const char*>(p);
+      buffer.assign(p, p + n);
+      swap_bytes(&buffer[0], n);
+      return reinterpret_cast<const char*>(&buffer[0]);
+   }
+
+   bool stream_sink(void* context, const char* bytes, size_t count)
+   {
+      ostream& out = *static_cast<ostream*>(context);
+      out.write(bytes, streamsize(count));
+      return bool(out);
+   }
+
+   bool fd_sink(void* context, const char* bytes, size_t count)
+   {
+      int fd = *static_cast<int*>(context);
+      while (count > 0)
+      {
+         ssize_t written = ::write(fd, bytes, count);
+         if (written < 0 && errno == EINTR)
+            continue;
+         if (written <= 0)
+            return false;
+         bytes += written;
+         count -= size_t(written);
+      }
+      return true;
+   }
+
+   // sources return the # of bytes read (fewer than count only at the
+   // end of the input) or -1 on an error
+   long long stream_source(void* context, char* bytes, size_t count)
+   {
+      istream& in = *static_cast<istream*>(context);
+      in.read(bytes, streamsize(count));
+      return in.bad() ? -1 : in.gcount();
+   }
+
+   long long fd_source(void* context, char* bytes, size_t count)
+   {
+      int fd = *static_cast<int*>(context);
+      size_t got = 0;
+      while (got < count)
+      {
+         ssize_t n = ::read(fd, bytes + got, count - got);
+         if (n < 0 && errno == EINTR)
+            continue;
+         if (n < 0)
+            return -1;
+         if (n == 0)
+            break;
+         got += size_t(n);
+      }
+      return (long long)got;
+   }
+
+   void apply_to(double* p, size_t n, double factor, bool multiply)
+   {
+#ifdef SEQUENCE_X86_SIMD
+      if (has_avx2())
+         apply_avx2(p, n, factor, multiply);
+      else
+         apply_sse2(p, n, factor, multiply);
+#else
+      for (size_t i = 0; i < n; ++i)
+         p[i] = multiply ? p[i] * factor : p[i] + factor;
+#endif
+   }
+}
+
 namespace CS3358_FA2021
 {
    // CONSTRUCTORS and DESTRUCTOR
-   sequence::sequence(size_type initial_capacity): capacity(initial_capacity), used(0)
+   sequence::sequence(size_type initial_capacity)
+      : shareable(true), used(0), current_index(0),
+        capacity(initial_capacity), tail(0),
+        growth_factor(DEFAULT_GROWTH_FACTOR), cursors(0), applied(0),
+        recording(false), step_open(false)
    {
-       if (capacity <= 0)
-       {
-        capacity = 1;
-       }
-       else
-       {
-           capacity = initial_capacity;
-       }
-       data = new value_type [initial_capacity];
-       current_index = used;
+      if (capacity < 1)
+         capacity = 1;
+      data = new value_type [capacity];
+      refs = new atomic<size_type>(1);
    }
 
-   sequence::sequence(const sequence& source): capacity(source.capacity), used(source.used)
+   sequence::sequence(const sequence& source)
+      : data(source.data), refs(source.refs), shareable(true),
+        used(source.used), current_index(source.current_index),
+        capacity(source.capacity), tail(source.tail),
+        growth_factor(source.growth_factor), cursors(0), applied(0),
+        recording(false), step_open(false)
    {
-      data = new value_type [capacity];
-      current_index = source.current_index;
-      for (size_type i = 0; i < used; ++i){
-        data[i]=source.data[i];
-      }
+      // share source's array; whichever of the two is modified first
+      // makes its own copy (see unshare), unless source has handed out
+      // iterators that can write to it, in which case copy it now
+      if (refs != 0)
+         refs->fetch_add(1, memory_order_relaxed);
+      if (!source.shareable)
+         unshare();
+   }
+
+   sequence::sequence(sequence&& source)
+      : data(source.data), refs(source.refs), shareable(source.shareable),
+        used(source.used), current_index(source.current_index),
+        capacity(source.capacity), tail(source.tail),
+        growth_factor(source.growth_factor), cursors(0),
+        history(std::move(source.history)), applied(source.applied),
+        recording(source.recording), step_open(source.step_open)
+   {
+      source.data = 0;
+      source.refs = 0;
+      source.shareable = true;
+      source.used = source.current_index = 0;
+      source.capacity = source.tail = 0;
+      source.items_replaced();
    }
 
    sequence::~sequence()
    {
-      delete [] data;
+      while (cursors != 0)
+         cursors->unbind();
+      release();
    }
 
    // MODIFICATION MEMBER FUNCTIONS
    void sequence::resize(size_type new_capacity)
    {
-      if (new_capacity < 1) new_capacity = 1;
       if (new_capacity < used) new_capacity = used;
+      if (new_capacity < 1) new_capacity = 1;
+      // keep the array (and every byte of the object) unless it's
+      // shared, since unshare relies on this to make the copy
+      if (new_capacity == capacity && refs != 0
+          && refs->load(memory_order_acquire) == 1)
+         return;
       value_type* newData = new value_type [new_capacity];
-        copy(data, data + used, newData);
-        delete [] data;
-        data = newData;
-        capacity = new_capacity;
+      copy(data, data + gap_start(), newData);
+      copy(data + capacity - tail, data + capacity,
+           newData + new_capacity - tail);
+      release();
+      data = newData;
+      refs = new atomic<size_type>(1);
+      shareable = true;   // no iterator points into the new array
+      capacity = new_capacity;
+   }
+
+   void sequence::reserve(size_type min_capacity)
+   {
+      if (min_capacity > capacity)
+         resize(min_capacity);
+   }
+
+   void sequence::shrink_to_fit()
+   {
+      if (capacity > used)
+         resize(used);
+   }
+
+   void sequence::set_growth_factor(double factor)
+   {
+      assert(factor > 1.0);
+      growth_factor = factor;
    }
 
    void sequence::start()
    {
-        if (used > 0){
-            current_index = used;
-        }
-        else
-            current_index = 0;
+      current_index = 0;
    }
 
    void sequence::advance()
    {
-       if (is_item()){
-            current_index++;
-       }
+      if (is_item())
+         ++current_index;
    }
 
    void sequence::insert(const value_type& entry)
    {
-       if (used == capacity){
-        resize((capacity*1.5)+1);
-       }
-       if (!is_item()){
-        current_index = 0;
-       }
-       for (size_type i = used; i > current_index; --i){
-        data [i]= data[i-1];
-       }
-       data[current_index] = entry;
-       ++used;
+      size_type position = is_item() ? current_index : 0;
+      put(position, entry);
+      current_index = position;
    }
 
    void sequence::attach(const value_type& entry)
    {
-       if (used == capacity){
-        resize((capacity*1.5)+1);
-       }
-       if (!is_item()){
-        current_index = used - 1;
-       }
-       ++current_index;
-       for (size_type i = used; i > current_index; --i){
-        data[i] = data[i-1];
-       }
-       data[current_index]=entry;
-       ++used;
+      size_type position = is_item() ? current_index + 1 : used;
+      put(position, entry);
+      current_index = position;
    }
 
    void sequence::remove_current()
    {
-       assert(is_item());
-       for (size_type i = current_index; i < used; ++i){
-        data[i] = data[i+1];
-       }
-       used--;
+      assert(is_item());
+      erase_range(current_index, current_index + 1);
+   }
+
+   void sequence::erase_range(size_type first, size_type last)
+   {
+      assert(first <= last && last <= used);
+      // with the gap just before first, widening the gap over the
+      // doomed items drops them
+      unshare();
+      move_gap(first);
+      // the doomed items are the first ones after the gap
+      if (recording)
+         for (size_type i = 0; i < last - first; ++i)
+            record(false, first, after_gap()[i], current_index);
+      used -= last - first;
+      tail -= last - first;
+      items_removed(first, last);
+   }
+
+   bool sequence::read_binary(istream& in, bool with_header)
+   {
+      if (!in)
+         return false;
+      // bytes left in the stream, if it can tell (-1 otherwise)
+      long long remaining = -1;
+      istream::pos_type here = in.tellg();
+      if (here != istream::pos_type(-1) && in.seekg(0, ios::end))
+      {
+         remaining = (long long)(in.tellg() - here);
+         in.seekg(here);
+      }
+      in.clear(in.rdstate() & ~ios::failbit);
+      return read_binary_from(stream_source, &in, remaining, with_header);
+   }
+
+   bool sequence::read_binary(int fd, bool with_header)
+   {
+      long long remaining = -1;
+      struct stat info;
+      off_t here = lseek(fd, 0, SEEK_CUR);
+      if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && here >= 0)
+         remaining = (long long)(info.st_size - here);
+      return read_binary_from(fd_source, &fd, remaining, with_header);
+   }
+
+   void sequence::checkpoint()
+   {
+      recording = true;
+      step_open = false;
+   }
+
+   bool sequence::undo()
+   {
+      if (applied == 0)
+         return false;
+      // replay the inverses newest first, without recording them
+      recording = false;
+      size_type current_after = current_index;
+      do
+      {
+         const edit& e = history[--applied];
+         if (e.inserted)
+            erase_range(e.position, e.position + 1);
+         else
+            put(e.position, e.item);
+      } while (!history[applied].starts_step);
+      history[applied].current_after = current_after;
+      current_index = history[applied].current_before;
+      recording = true;
+      step_open = false;
+      return true;
+   }
+
+   bool sequence::redo()
+   {
+      if (applied == history.size())
+         return false;
+      recording = false;
+      size_type first = applied;
+      do
+      {
+         const edit& e = history[applied++];
+         if (e.inserted)
+            put(e.position, e.item);
+         else
+            erase_range(e.position, e.position + 1);
+      } while (applied < history.size() && !history[applied].starts_step);
+      current_index = history[first].current_after;
+      recording = true;
+      step_open = false;
+      return true;
+   }
+
+   void sequence::clear_history()
+   {
+      vector<edit>().swap(history);
+      applied = 0;
+      recording = false;
+      step_open = false;
    }
 
    sequence& sequence::operator=(const sequence& source)
    {
-      value_type *newData = new value_type [source.capacity];
-      copy (source.data, source.data + source.used, newData);
-      delete [] data;
-      used = source.used;
-      capacity = source.capacity;
-      if (source.is_item())
-        current_index = source.current_index;
-      else
-        current_index = used;
+      if (this != &source)
+      {
+         // take the new reference before dropping the old one, in case
+         // both sequences already share the same array
+         if (source.refs != 0)
+            source.refs->fetch_add(1, memory_order_relaxed);
+         release();
+         data = source.data;
+         refs = source.refs;
+         shareable = true;
+         used = source.used;
+         current_index = source.current_index;
+         capacity = source.capacity;
+         tail = source.tail;
+         growth_factor = source.growth_factor;
+         if (!source.shareable)
+            unshare();
+         items_replaced();
+      }
+      return *this;
+   }
+
+   sequence& sequence::operator=(sequence&& source)
+   {
+      if (this != &source)
+      {
+         release();
+         data = source.data;
+         refs = source.refs;
+         shareable = source.shareable;
+         used = source.used;
+         current_index = source.current_index;
+         capacity = source.capacity;
+         tail = source.tail;
+         growth_factor = source.growth_factor;
+         source.data = 0;
+         source.refs = 0;
+         source.shareable = true;
+         source.used = source.current_index = 0;
+         source.capacity = source.tail = 0;
+         items_replaced();
+         history.swap(source.history);
+         applied = source.applied;
+         recording = source.recording;
+         step_open = source.step_open;
+         source.items_replaced();
+      }
+      return *this;
+   }
+
+   void sequence::sort(int thread_count)
+   {
+      clear_history();
+      parallel_sort(make_contiguous(), used, thread_count, false);
+   }
+
+   void sequence::stable_sort(int thread_count)
+   {
+      clear_history();
+      parallel_sort(make_contiguous(), used, thread_count, true);
+   }
+
+   sequence::iterator sequence::begin()
+   {
+      unshare();
+      shareable = false;   // see INVARIANT 4
+      return iterator(data, gap_start(), capacity - used, 0);
+   }
+
+   sequence::iterator sequence::end()
+   {
+      unshare();
+      shareable = false;   // see INVARIANT 4
+      return iterator(data, gap_start(), capacity - used, used);
+   }
+
+   void sequence::scale(value_type factor)
+   {
+      clear_history();
+      unshare();
+      apply_to(data, gap_start(), factor, true);
+      apply_to(after_gap(), tail, factor, true);
+   }
+
+   void sequence::offset(value_type amount)
+   {
+      clear_history();
+      unshare();
+      apply_to(data, gap_start(), amount, false);
+      apply_to(after_gap(), tail, amount, false);
    }
 
    // CONSTANT MEMBER FUNCTIONS
@@ -163,19 +1109,465 @@ namespace CS3358_FA2021
 
    bool sequence::is_item() const
    {
-    if (current_index >= used || used == 0)
-        return false;
-    else if (current_index < used)
-        return true;
-
+      return current_index < used;
    }
 
    sequence::value_type sequence::current() const
+   {
+      assert(is_item());
+      return data[physical(current_index)];
+   }
+
+   sequence::const_iterator sequence::begin() const
+   {
+      return const_iterator(data, gap_start(), capacity - used, 0);
+   }
+
+   sequence::const_iterator sequence::end() const
+   {
+      return const_iterator(data, gap_start(), capacity - used, used);
+   }
+
+   bool sequence::write_binary(ostream& out, bool with_header) const
+   {
+      return write_binary_to(stream_sink, &out, with_header);
+   }
+
+   bool sequence::write_binary(int fd, bool with_header) const
+   {
+      return write_binary_to(fd_sink, &fd, with_header);
+   }
+
+   sequence::value_type sequence::sum(bool compensated) const
+   {
+      if (!compensated)
+         return sum_of(data, gap_start()) + sum_of(after_gap(), tail);
+      double total = 0, comp = 0;
+      kahan_sum_of(data, gap_start(), total, comp);
+      kahan_sum_of(after_gap(), tail, total, comp);
+      return total + comp;
+   }
+
+   sequence::value_type sequence::mean() const
+   {
+      assert(used > 0);
+      return sum() / used;
+   }
+
+   sequence::value_type sequence::min() const
+   {
+      assert(used > 0);
+      value_type first = data[physical(0)];
+      return extreme_of(after_gap(), tail,
+                        extreme_of(data, gap_start(), first, false), false);
+   }
+
+   sequence::value_type sequence::max() const
+   {
+      assert(used > 0);
+      value_type first = data[physical(0)];
+      return extreme_of(after_gap(), tail,
+                        extreme_of(data, gap_start(), first, true), true);
+   }
+
+   sequence::value_type sequence::variance() const
+   {
+      // two passes (mean first) rather than the sum of squares minus
+      // the squared sum, which cancels badly when the mean is large
+      value_type m = mean();
+      return (squared_deviation_of(data, gap_start(), m)
+              + squared_deviation_of(after_gap(), tail, m)) / used;
+   }
+
+   sequence::value_type sequence::dot(const sequence& other) const
+   {
+      assert(other.used == used);
+      // the two gaps split the items at different places, so walk the
+      // (at most three) runs that are contiguous in both
+      value_type result = 0;
+      size_type i = 0;
+      while (i < used)
+      {
+         size_type end = i < gap_start() ? gap_start() : used;
+         size_type other_end =
+            i < other.gap_start() ? other.gap_start() : used;
+         size_type run = (end < other_end ? end : other_end) - i;
+         result += dot_of(data + physical(i),
+                          other.data + other.physical(i), run);
+         i += run;
+      }
+      return result;
+   }
+
+   // PRIVATE HELPER FUNCTIONS
+   bool sequence::write_binary_to(byte_sink sink, void* context,
+                                  bool with_header) const
+   {
+      const value_type* segment[2] = { data, after_gap() };
+      size_type length[2] = { gap_start(), tail };
+      vector<double> buffer;
+
+      if (with_header)
+      {
+         unsigned int crc = 0;
+         for (int s = 0; s < 2; ++s)
+            for (size_type i = 0; i < length[s]; i += IO_CHUNK_ITEMS)
+            {
+               size_type n = std::min(IO_CHUNK_ITEMS, length[s] - i);
+               crc = crc32_update(crc, reinterpret_cast<const unsigned char*>
+                                  (file_bytes(segment[s] + i, n, buffer)),
+                                  n * sizeof(double));
+            }
+         unsigned char header[BINARY_HEADER_SIZE] = { 'S', 'Q', 'B', '1' };
+         put_le(header + 8, used, 8);
+         put_le(header + 16, crc, 4);
+         if (!sink(context, reinterpret_cast<const char*>(header),
+                   BINARY_HEADER_SIZE))
+            return false;
+      }
+
+      for (int s = 0; s < 2; ++s)
+         for (size_type i = 0; i < length[s]; i += IO_CHUNK_ITEMS)
+         {
+            size_type n = std::min(IO_CHUNK_ITEMS, length[s] - i);
+            if (!sink(context, file_bytes(segment[s] + i, n, buffer),
+                      n * sizeof(double)))
+               return false;
+         }
+      return true;
+   }
+
+   bool sequence::read_binary_from(byte_source source, void* context,
+                                   long long remaining, bool with_header)
+   {
+      unsigned long long count = 0;
+      unsigned int expected_crc = 0;
+      if (with_header)
+      {
+         unsigned char header[BINARY_HEADER_SIZE];
+         if (source(context, reinterpret_cast<char*>(header),
+                    BINARY_HEADER_SIZE) != (long long)BINARY_HEADER_SIZE
+             || memcmp(header, "SQB1", 4) != 0)
+            return false;
+         count = get_le(header + 8, 8);
+         expected_crc = (unsigned int)get_le(header + 16, 4);
+         if (remaining >= 0)
+         {
+            remaining -= BINARY_HEADER_SIZE;
+            if ((unsigned long long)remaining / sizeof(double) < count)
+               return false;   // the input is too short to hold them
+         }
+      }
+
+      else if (remaining >= 0)
+      {
+         // without a header, the input's length gives the count
+         if (remaining % sizeof(double) != 0)
+            return false;
+         count = (unsigned long long)remaining / sizeof(double);
+      }
+      bool bounded = with_header || remaining >= 0;
+
+      // when the input's length is unknown, don't trust a header's count
+      // for more than a chunk; the array then grows geometrically
+      size_type expected = !bounded ? IO_CHUNK_ITEMS
+                           : remaining >= 0 || count < IO_CHUNK_ITEMS
+                             ? count : IO_CHUNK_ITEMS;
+      sequence loaded(expected > 0 ? expected : 1);
+      unsigned int crc = 0;
+      while (!bounded || loaded.used < count)
+      {
+         size_type want = IO_CHUNK_ITEMS;
+         if (bounded && count - loaded.used < want)
+            want = count - loaded.used;
+         if (loaded.used + want > loaded.capacity)
+            loaded.resize(std::max(loaded.used + want, 2 * loaded.capacity));
+         // loaded only grows at its end, so its gap starts at used
+         char* dest = reinterpret_cast<char*>(loaded.data + loaded.used);
+         long long got = source(context, dest, want * sizeof(double));
+         if (got < 0 || got % sizeof(double) != 0)
+            return false;   // read error, or a partial item at the end
+         size_type n = size_type(got) / sizeof(double);
+         if (with_header)
+            crc = crc32_update(crc, reinterpret_cast<unsigned char*>(dest),
+                               size_type(got));
+         if (!host_is_little_endian())
+            swap_bytes(loaded.data + loaded.used, n);
+         loaded.used += n;   // filling the gap, so tail stays 0
+         if (n < want)
+            break;   // end of the input
+      }
+      if ((bounded && loaded.used != count)
+          || (with_header && crc != expected_crc))
+         return false;
+
+      loaded.current_index = loaded.used;
+      loaded.growth_factor = growth_factor;
+      *this = std::move(loaded);
+      return true;
+   }
+
+   sequence::size_type sequence::gap_start() const
+   {
+      return used - tail;
+   }
+
+   sequence::size_type sequence::physical(size_type index) const
+   {
+      return index < gap_start() ? index : index + (capacity - used);
+   }
+
+   sequence::value_type* sequence::after_gap() const
+   {
+      return data + (capacity - tail);
+   }
+
+   void sequence::grow_if_full()
+   {
+      if (used == capacity)
+         resize(size_type(capacity * growth_factor) + 1);
+   }
+
+   sequence::value_type* sequence::make_room(size_type position,
+                                             size_type count)
+   {
+      if (used + count > capacity)
+      {
+         size_type grown = size_type(capacity * growth_factor) + 1;
+         resize(used + count > grown ? used + count : grown);
+      }
+      unshare();
+      move_gap(position);
+      value_type* room = data + gap_start();
+      used += count;   // the new items go before the gap
+      items_inserted(position, count);
+      return room;
+   }
+
+   void sequence::put(size_type position, const value_type& entry)
+   {
+      record(true, position, entry, current_index);
+      grow_if_full();
+      unshare();
+      move_gap(position);
+      data[gap_start()] = entry;
+      ++used;   // the new item goes before the gap, so tail stays
+      items_inserted(position, 1);
+   }
+
+   void sequence::items_inserted(size_type position, size_type count)
+   {
+      if (current_index >= position)
+         current_index += count;
+      for (cursor* c = cursors; c != 0; c = c->next)
+         if (c->index >= position)
+            c->index += count;
+   }
+
+   void sequence::items_removed(size_type first, size_type last)
+   {
+      if (current_index >= last)
+         current_index -= last - first;
+      else if (current_index > first)
+         current_index = first;
+      for (cursor* c = cursors; c != 0; c = c->next)
+      {
+         if (c->index >= last)
+            c->index -= last - first;
+         else if (c->index > first)
+            c->index = first;
+      }
+   }
+
+   void sequence::items_replaced()
+   {
+      for (cursor* c = cursors; c != 0; c = c->next)
+         c->index = used;
+      clear_history();
+   }
+
+   vector<sequence::size_type*> sequence::positions_in_order()
+   {
+      vector<size_type*> positions(1, &current_index);
+      for (cursor* c = cursors; c != 0; c = c->next)
+         positions.push_back(&c->index);
+      std::sort(positions.begin(), positions.end(),
+                [](const size_type* a, const size_type* b) { return *a < *b; });
+      return positions;
+   }
+
+   void sequence::record(bool inserted, size_type position,
+                         const value_type& item, size_type current_before)
+   {
+      if (!recording)
+         return;
+      history.resize(applied);   // a new edit ends what could be redone
+      edit e;
+      e.inserted = inserted;
+      e.starts_step = !step_open;
+      e.position = position;
+      e.item = item;
+      e.current_before = current_before;
+      e.current_after = current_before;
+      history.push_back(e);
+      ++applied;
+      step_open = true;
+   }
+
+   void sequence::record_inserted(size_type position, size_type count,
+                                  size_type current_before)
+   {
+      // make_room left the gap just after the new items
+      for (size_type i = 0; recording && i < count; ++i)
+         record(true, position + i, data[gap_start() - count + i],
+                current_before);
+   }
+
+   sequence::value_type* sequence::make_contiguous()
+   {
+      unshare();
+      move_gap(used);
+      return data;
+   }
+
+   void sequence::unshare()
+   {
+      // a count of 1 can't go up behind our back: only a copy of this
+      // very sequence could share the array, and copying a sequence
+      // while modifying it is a data race anyway
+      if (refs != 0 && refs->load(memory_order_acquire) != 1)
+         resize(capacity);
+   }
+
+   void sequence::release()
+   {
+      if (refs != 0 && refs->fetch_sub(1, memory_order_acq_rel) == 1)
+      {
+         delete [] data;
+         delete refs;
+      }
+      data = 0;
+      refs = 0;
+   }
+
+   void sequence::move_gap(size_type position)
+   {
+      size_type gap = capacity - used;
+      size_type start = gap_start();
+      if (position < start)
+         copy_backward(data + position, data + start, data + start + gap);
+      else if (position > start)
+         copy(data + start + gap, data + position + gap, data + start);
+      tail = used - position;
+   }
+
+   // sequence::cursor
+   sequence::cursor::cursor() : seq(0), index(0), prev(0), next(0) { }
+
+   sequence::cursor::cursor(sequence& s) : seq(0), index(0), prev(0), next(0)
+   {
+      bind(&s);
+   }
+
+   sequence::cursor::cursor(const cursor& source)
+      : seq(0), index(source.index), prev(0), next(0)
+   {
+      bind(source.seq);
+   }
+
+   sequence::cursor::~cursor()
+   {
+      unbind();
+   }
+
+   sequence::cursor& sequence::cursor::operator=(const cursor& source)
+   {
+      if (this != &source)
+      {
+         if (seq != source.seq)
+         {
+            unbind();
+            bind(source.seq);
+         }
+         index = source.index;
+      }
+      return *this;
+   }
+
+   bool sequence::cursor::is_bound() const
+   {
+      return seq != 0;
+   }
+
+   void sequence::cursor::start()
+   {
+      index = 0;
+   }
+
+   void sequence::cursor::advance()
    {
       if (is_item())
+         ++index;
+   }
+
+   void sequence::cursor::insert(const value_type& entry)
+   {
+      assert(is_bound());
+      size_type position = is_item() ? index : 0;
+      seq->put(position, entry);
+      index = position;
+   }
+
+   void sequence::cursor::attach(const value_type& entry)
+   {
+      assert(is_bound());
+      size_type position = is_item() ? index + 1 : seq->used;
+      seq->put(position, entry);
+      index = position;
+   }
+
+   void sequence::cursor::remove_current()
+   {
+      assert(is_item());
+      seq->erase_range(index, index + 1);
+   }
+
+   bool sequence::cursor::is_item() const
+   {
+      return seq != 0 && index < seq->used;
+   }
+
+   sequence::value_type sequence::cursor::current() const
+   {
+      assert(is_item());
+      return seq->data[seq->physical(index)];
+   }
+
+   void sequence::cursor::bind(sequence* s)
+   {
+      seq = s;
+      if (seq != 0)
       {
-          return data [current_index];
+         next = seq->cursors;
+         if (next != 0)
+            next->prev = this;
+         seq->cursors = this;
       }
    }
-}
 
+   void sequence::cursor::unbind()
+   {
+      if (seq != 0)
+      {
+         if (prev != 0)
+            prev->next = next;
+         else
+            seq->cursors = next;
+         if (next != 0)
+            next->prev = prev;
+      }
+      seq = 0;
+      prev = next = 0;
+      index = 0;
+   }
+}
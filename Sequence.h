@@ -12,10 +12,28 @@
 //    sequence::size_type is the data type of any variable that keeps
 //    track of how many items are in a sequence.
 //
+//   typedef ____ iterator
+//   typedef ____ const_iterator
+//    Random-access iterators over the items of a sequence, front to
+//    back (an iterator may be converted to a const_iterator). They
+//    work with the standard algorithms (std::sort, std::lower_bound,
+//    std::for_each with an execution policy, ...). Iterators are
+//    invalidated by any function that adds or removes items or
+//    changes the capacity; the cursor functions (start, advance,
+//    current) do not affect them.
+//
+//   class cursor
+//    A sequence::cursor is a current-item position of its own in a
+//    sequence it is bound to (see CURSORS below).
+//
 //   static const size_type DEFAULT_CAPACITY = _____
 //    sequence::DEFAULT_CAPACITY is the default initial capacity of a
 //    sequence that is created by the default constructor.
 //
+//   static constexpr double DEFAULT_GROWTH_FACTOR = _____
+//    sequence::DEFAULT_GROWTH_FACTOR is the factor by which a full
+//    sequence grows its capacity unless set_growth_factor is used.
+//
 // CONSTRUCTOR for the sequence class:
 //   sequence(size_type initial_capacity = DEFAULT_CAPACITY)
 //    Pre:  initial_capacity > 0
@@ -24,6 +42,12 @@
 //      allocating new memory) until this capacity is reached.
 //    Note: If Pre is not met, initial_capacity will be adjusted to 1.
 //
+//   sequence(sequence&& source)
+//    Pre:  none
+//    Post: The sequence has taken over the items, capacity and current
+//      item of source without copying them; source is left an empty
+//      sequence with no current item (and no allocated storage).
+//
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void resize(size_type new_capacity)
 //    Pre:  new_capacity > 0
@@ -33,7 +57,24 @@
 //      allocating new memory) until this new capacity is reached.
 //    Note: If new_capacity is less than used, it will be made equal to
 //      to used (in order to preserve existing data). Thereafter, if Pre
-//      is not met, new_capacity will be adjusted to 1.
+//      is not met, new_capacity will be adjusted to 1. If that leaves
+//      the capacity as it was, the sequence is not changed at all.
+//
+//   void reserve(size_type min_capacity)
+//    Pre:  none
+//    Post: The sequence's capacity is at least min_capacity (it is
+//      never reduced by reserve).
+//
+//   void shrink_to_fit()
+//    Pre:  none
+//    Post: The sequence's capacity has been reduced to the number of
+//      items (or 1 for an empty sequence).
+//
+//   void set_growth_factor(double factor)
+//    Pre:  factor > 1.0
+//    Post: When insert/attach find the sequence full, the capacity
+//      will grow from c to c * factor + 1 (the default factor is
+//      DEFAULT_GROWTH_FACTOR).
 //
 //   void start()
 //    Pre:  none
@@ -63,6 +104,29 @@
 //      case, the newly inserted item is now the current item of the
 //      sequence.
 //
+//   template <class ForwardIterator>
+//   void insert_range(ForwardIterator first, ForwardIterator last)
+//    Pre:  [first, last) is a valid range of items convertible to
+//      value_type that does not refer into this sequence.
+//    Post: Copies of the items in [first, last) have been inserted, in
+//      order, before the current item (or at the front of the
+//      sequence if there was no current item). If the range was not
+//      empty, the last item inserted is now the current item;
+//      otherwise the sequence is unchanged.
+//    Note: Capacity is grown at most once and the items after the
+//      insertion point are shifted at most once, however long the
+//      range is.
+//
+//   template <class ForwardIterator>
+//   void attach_range(ForwardIterator first, ForwardIterator last)
+//    Pre:  Same as insert_range.
+//    Post: Copies of the items in [first, last) have been inserted, in
+//      order, after the current item (or at the end of the sequence
+//      if there was no current item). If the range was not empty, the
+//      last item inserted is now the current item; otherwise the
+//      sequence is unchanged. (Equivalent to calling attach on each
+//      item in turn, but with the cost noted for insert_range.)
+//
 //   void remove_current()
 //    Pre:  is_item returns true.
 //    Post: The current item has been removed from the sequence, and
@@ -70,6 +134,111 @@
 //      item. If the current item was already the last item in the
 //      sequence, then there is no longer any current item.
 //
+//   void erase_range(size_type first, size_type last)
+//    Pre:  first <= last <= size()
+//    Post: The items at indexes first through last-1 (counting the
+//      first item as 0) have been removed. If the current item was
+//      one of them, the item after the removed ones (if there is one)
+//      is now the current item; otherwise the current item is
+//      unchanged (if there was no current item, there still is none).
+//    Note: Costs O(last - first) plus the distance from the last edit,
+//      rather than shifting the rest of the sequence.
+//
+//   template <class Predicate>
+//   size_type remove_if(Predicate pred)
+//    Pre:  pred can be called with a const value_type& and returns
+//      something convertible to bool.
+//    Post: Every item x for which pred(x) was true has been removed,
+//      the other items keep their order, and the number of items
+//      removed is returned. pred has been called once for each item,
+//      front to back. If the current item was removed, the first
+//      remaining item after it (if there is one) is now the current
+//      item; otherwise the current item is unchanged.
+//    Note: All items are compacted in a single pass, O(size()).
+//
+//   bool read_binary(std::istream& in, bool with_header = true)
+//   bool read_binary(int fd, bool with_header = true)
+//    Pre:  in (or the open file descriptor fd) is positioned at data
+//      written by write_binary with the same with_header setting.
+//    Post: If with_header is true, one sequence's worth of data has
+//      been read; otherwise everything up to the end of the input has
+//      been read. If the data was complete and valid (the header had
+//      the right magic and its CRC matched), the items read have
+//      replaced the items of the sequence, there is no current item,
+//      and true is returned. Otherwise false is returned and the
+//      sequence is unchanged.
+//    Note: Reads go straight into the sequence's array, 1 MB at a
+//      time; when the input's remaining length can be found (regular
+//      files), the array is allocated once up front.
+//
+//   void checkpoint()
+//    Pre:  none
+//    Post: A new undo step has been begun: the edits from now on (up
+//      to the next checkpoint, undo or redo) are undone together. The
+//      first call starts recording edits (see EDIT HISTORY below).
+//
+//   bool undo()
+//    Pre:  none
+//    Post: If there are recorded edits to undo, the last step of
+//      them (the edits made since the checkpoint, undo or redo before
+//      them) has been undone, restoring the items and the current item
+//      of just before the step's first edit, and true is returned.
+//      Otherwise the sequence is unchanged and false is returned.
+//
+//   bool redo()
+//    Pre:  none
+//    Post: If a step has been undone and not redone, and no edit has
+//      been recorded since, the most recently undone step has been
+//      made again, restoring the current item of when it was undone,
+//      and true is returned. Otherwise the sequence is unchanged and
+//      false is returned.
+//
+//   void clear_history()
+//    Pre:  none
+//    Post: All recorded edits have been forgotten (undo and redo
+//      return false), and edits are no longer recorded until the next
+//      checkpoint.
+//
+//   sequence& operator=(sequence&& source)
+//    Pre:  none
+//    Post: Same as the move constructor, except that the storage the
+//      sequence had before has been freed.
+//
+//   void sort(int thread_count = 0)
+//   void stable_sort(int thread_count = 0)
+//    Pre:  No item is NaN.
+//    Post: The items have been put in ascending order. With
+//      stable_sort, items that compare equal (only 0.0 and -0.0 can)
+//      keep their relative order. The current item (if any) is the
+//      item now at the same position as the old current item.
+//    Note: Sequences of at least 2 * 65536 items are sorted by a
+//      merge sort using up to thread_count threads (0 means one per
+//      hardware thread), each given at least 65536 items; smaller
+//      ones are sorted by the calling thread alone.
+//
+//   iterator begin()
+//   iterator end()
+//    Pre:  none
+//    Post: An iterator to the first item (begin) or just past the last
+//      item (end) is returned; they are equal if the sequence is empty.
+//      Items may be changed through them (but not added or removed).
+//      The current item (if any) stays at the same position.
+//    Note: Like the functions that modify the sequence, these first
+//      give the sequence its own copy of the items if it shares them
+//      with a copy. From then on, until the capacity changes or the
+//      sequence is assigned to, copies of it don't share its items
+//      (see VALUE SEMANTICS).
+//
+//   void scale(value_type factor)
+//    Pre:  none
+//    Post: Every item in the sequence has been multiplied by factor.
+//      The current item (if any) is unchanged.
+//
+//   void offset(value_type amount)
+//    Pre:  none
+//    Post: amount has been added to every item in the sequence. The
+//      current item (if any) is unchanged.
+//
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
 //    Pre:  none
@@ -86,13 +255,169 @@
 //    Pre:  is_item() returns true.
 //    Post: The item returned is the current item in the sequence.
 //
+//   const_iterator begin() const
+//   const_iterator end() const
+//    Pre:  none
+//    Post: As for the non-const begin and end, except that the items
+//      cannot be changed through the iterators returned.
+//
+//   value_type sum(bool compensated = false) const
+//    Pre:  none
+//    Post: The sum of the items is returned (0 for an empty sequence).
+//      If compensated is true, the sum is accumulated with Kahan
+//      compensation, so its rounding error stays near one ulp
+//      however many items there are, at some extra cost.
+//
+//   value_type mean() const
+//    Pre:  size() > 0
+//    Post: The arithmetic mean of the items is returned.
+//
+//   value_type min() const
+//   value_type max() const
+//    Pre:  size() > 0, and no item is NaN.
+//    Post: The smallest (largest) item is returned.
+//
+//   value_type variance() const
+//    Pre:  size() > 0
+//    Post: The population variance of the items (the mean of their
+//      squared distances from mean()) is returned.
+//
+//   value_type dot(const sequence& other) const
+//    Pre:  other.size() == size()
+//    Post: The dot product of the sequence and other (the sum of the
+//      products of items with the same position) is returned.
+//
+//   bool write_binary(std::ostream& out, bool with_header = true) const
+//   bool write_binary(int fd, bool with_header = true) const
+//    Pre:  out is open for binary output (or fd is a file descriptor
+//      open for writing).
+//    Post: The items, front to back, have been written in the binary
+//      format below, and true is returned, or false if a write failed.
+//      The sequence (including its current item) is unchanged.
+//    Note: The items are written straight from the sequence's array,
+//      1 MB at a time (plus one pass over them for the CRC).
+//
+// BINARY FORMAT (all numbers little-endian):
+//   Optional 24-byte header:
+//     bytes  0 -  3  the magic "SQB1"
+//     bytes  4 -  7  reserved (0)
+//     bytes  8 - 15  the number of items n
+//     bytes 16 - 19  CRC-32 (as in zlib) of the items that follow
+//     bytes 20 - 23  reserved (0)
+//   followed by the items as IEEE-754 doubles, 8 bytes each (n of
+//   them if there is a header).
+//
+// NOTE on the numeric functions (sum through dot, scale and offset):
+//   They work straight on the stored items rather than through the
+//   cursor, using AVX2 or SSE2 vector instructions where the machine
+//   has them (chosen at run time) and plain loops otherwise. Since
+//   the items are added in a different order than a front-to-back
+//   loop would, results may differ from such a loop in the last few
+//   bits. Compensated summation relies on the compiler keeping
+//   floating-point operations in order (no -ffast-math).
+//
+// EDIT HISTORY:
+//   Edits are recorded from the first call to checkpoint on (until
+//   clear_history), so that they can be undone and redone. Each edit
+//   is logged as its own inverse -- the position and value of one item
+//   inserted or removed -- so the history grows with the number of
+//   items inserted or removed, not with the size of the sequence, and
+//   undoing or redoing a single-item edit is as cheap as the edit.
+//   - Recorded: insert, attach, remove_current, insert_range,
+//     attach_range, erase_range and remove_if, whether called on the
+//     sequence or through a cursor. Cursors are adjusted by undo and
+//     redo just as by the edits themselves (see CURSORS).
+//   - Making a recorded edit after an undo discards what could have
+//     been redone.
+//   - sort, stable_sort, scale, offset, read_binary and assignment
+//     rewrite the sequence wholesale; they clear the history.
+//   - Changes made through iterators are not recorded (undo and redo
+//     leave such changed values as they are).
+//   Copies don't share history: a copy starts with none, and moving a
+//   sequence moves its history along with its items.
+//
+// CURSORS (class sequence::cursor):
+//   Any number of cursors may be bound to one sequence, each with its
+//   own current item, in addition to the sequence's own. They refer
+//   to the sequence's items rather than copying them.
+//
+//   cursor()
+//    Post: The cursor is not bound to any sequence; it has no current
+//      item.
+//
+//   cursor(sequence& s)
+//    Post: The cursor is bound to s, and its current item is the first
+//      item of s (none if s is empty).
+//
+//   cursor(const cursor& source)
+//   cursor& operator=(const cursor& source)
+//    Post: The cursor is bound to the same sequence as source (if any)
+//      and has the same current item.
+//
+//   bool is_bound() const
+//    Post: True is returned if the cursor is bound to a sequence.
+//
+//   void start()
+//   void advance()
+//   bool is_item() const
+//   value_type current() const
+//    Same as for sequence, applied to the cursor's current item in the
+//    sequence it is bound to (is_item is false for an unbound cursor).
+//
+//   void insert(const value_type& entry)
+//   void attach(const value_type& entry)
+//   void remove_current()
+//    Pre:  The cursor is bound (and, for remove_current, is_item()
+//      returns true).
+//    Post: Same as for sequence, applied to the cursor's current item
+//      in the sequence it is bound to.
+//
+//   How edits affect current items: whenever items are inserted into
+//   or removed from a sequence (through the sequence or any cursor
+//   bound to it), the current items of the sequence and of all of its
+//   other cursors stay on the same items; the index they are at
+//   shifts as needed. If a current item is removed, the item after it
+//   (if any) becomes current instead, just as with remove_current.
+//   Cursors with no current item keep having none. sort and
+//   stable_sort keep every current item at the same position (the
+//   item there changes), and assigning to a sequence (or moving from
+//   it) leaves all cursors bound to it with no current item.
+//   Cursors stay bound to the sequence object, not its items: a copy
+//   of the sequence has no cursors bound to it, and a cursor whose
+//   sequence is destroyed becomes unbound.
+//   Cursors may read a sequence from different threads at the same
+//   time, as long as nothing modifies it (binding or unbinding a
+//   cursor counts as modifying its sequence); for fully independent
+//   readers, hand each thread a copy, which is O(1) (see VALUE
+//   SEMANTICS).
+//
 // VALUE SEMANTICS for the sequence class:
 //   Assignments and the copy constructor may be used with sequence
-//   objects.
+//   objects. Sequences returned from functions or explicitly moved
+//   (std::move) are moved, not copied.
+//   Copying is O(1): a copy shares the items of the original
+//   (copy-on-write) until either one is modified (insert, attach,
+//   remove_current, resize and the other functions that change the
+//   items or capacity, or the non-const begin/end), which then makes
+//   its own copy first. A sequence whose non-const begin or end has
+//   been called is copied right away instead (O(n)), until its
+//   capacity changes or it is assigned to, so that writes through
+//   the iterators they returned never show up in a copy made after
+//   them. The current item is never shared: each copy moves its
+//   cursor independently, and start/advance never copy.
+//   Copies that share items may be used from different threads at
+//   the same time (the sharing count is atomic), as long as each
+//   single sequence object is used by one thread at a time.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
 #include <cstdlib>  // provides size_t
+#include <cstddef>   // provides ptrdiff_t
+#include <iterator>  // provides distance, random_access_iterator_tag
+#include <algorithm> // provides copy
+#include <atomic>
+#include <iosfwd>
+#include <vector>
 
 namespace CS3358_FA2021
 {
@@ -102,29 +427,261 @@ namespace CS3358_FA2021
       // TYPEDEFS and MEMBER CONSTANTS
       typedef double value_type;
       typedef std::size_t size_type;
+      template <class Item> class basic_iterator;
+      class cursor;
+      typedef basic_iterator<value_type> iterator;
+      typedef basic_iterator<const value_type> const_iterator;
       static const size_type DEFAULT_CAPACITY = 30;
+      static constexpr double DEFAULT_GROWTH_FACTOR = 1.5;
       // CONSTRUCTORS and DESTRUCTOR
       sequence(size_type initial_capacity = DEFAULT_CAPACITY);
       sequence(const sequence& source);
+      sequence(sequence&& source);
       ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
       void resize(size_type new_capacity);
+      void reserve(size_type min_capacity);
+      void shrink_to_fit();
+      void set_growth_factor(double factor);
       void start();
       void advance();
       void insert(const value_type& entry);
       void attach(const value_type& entry);
+      template <class ForwardIterator>
+      void insert_range(ForwardIterator first, ForwardIterator last);
+      template <class ForwardIterator>
+      void attach_range(ForwardIterator first, ForwardIterator last);
       void remove_current();
+      void erase_range(size_type first, size_type last);
+      template <class Predicate>
+      size_type remove_if(Predicate pred);
+      bool read_binary(std::istream& in, bool with_header = true);
+      bool read_binary(int fd, bool with_header = true);
+      void checkpoint();
+      bool undo();
+      bool redo();
+      void clear_history();
       sequence& operator=(const sequence& source);
+      sequence& operator=(sequence&& source);
+      void sort(int thread_count = 0);
+      void stable_sort(int thread_count = 0);
+      iterator begin();
+      iterator end();
+      void scale(value_type factor);
+      void offset(value_type amount);
       // CONSTANT MEMBER FUNCTIONS
+      const_iterator begin() const;
+      const_iterator end() const;
       size_type size() const;
       bool is_item() const;
       value_type current() const;
+      bool write_binary(std::ostream& out, bool with_header = true) const;
+      bool write_binary(int fd, bool with_header = true) const;
+      value_type sum(bool compensated = false) const;
+      value_type mean() const;
+      value_type min() const;
+      value_type max() const;
+      value_type variance() const;
+      value_type dot(const sequence& other) const;
    private:
       value_type* data;
+      std::atomic<size_type>* refs;
+      bool shareable;
       size_type used;
       size_type current_index;
       size_type capacity;
+      size_type tail;
+      double growth_factor;
+      cursor* cursors;
+      struct edit
+      {
+         bool inserted;            // else removed
+         bool starts_step;         // first edit after a checkpoint
+         size_type position;       // index of the item inserted/removed
+         value_type item;          // the item inserted/removed
+         size_type current_before; // current_index before the step
+         size_type current_after;  // current_index when it was undone
+      };
+      std::vector<edit> history;
+      size_type applied;
+      bool recording;
+      bool step_open;
+      void grow_if_full();
+      value_type* make_room(size_type position, size_type count);
+      value_type* make_contiguous();
+      void put(size_type position, const value_type& entry);
+      void items_inserted(size_type position, size_type count);
+      void items_removed(size_type first, size_type last);
+      void items_replaced();
+      std::vector<size_type*> positions_in_order();
+      void record(bool inserted, size_type position, const value_type& item,
+                  size_type current_before);
+      void record_inserted(size_type position, size_type count,
+                           size_type current_before);
+      typedef bool (*byte_sink)(void* context, const char* bytes,
+                                size_type count);
+      typedef long long (*byte_source)(void* context, char* bytes,
+                                       size_type count);
+      bool write_binary_to(byte_sink sink, void* context,
+                           bool with_header) const;
+      bool read_binary_from(byte_source source, void* context,
+                            long long remaining, bool with_header);
+      size_type gap_start() const;
+      size_type physical(size_type index) const;
+      value_type* after_gap() const;
+      void unshare();
+      void release();
+      void move_gap(size_type position);
    };
+
+   // The iterators map an item's index through the gap (see the
+   // INVARIANT in Sequence.cpp) each time they are dereferenced, so
+   // they only need the layout that was in place when they were made.
+   template <class Item>
+   class sequence::basic_iterator
+   {
+   public:
+      typedef std::random_access_iterator_tag iterator_category;
+      typedef sequence::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Item* pointer;
+      typedef Item& reference;
+
+      basic_iterator() : items(0), gap_start(0), gap(0), index(0) { }
+      // also converts an iterator into a const_iterator
+      basic_iterator(const basic_iterator<sequence::value_type>& other)
+         : items(other.items), gap_start(other.gap_start), gap(other.gap),
+           index(other.index) { }
+
+      reference operator*() const
+         { return items[index < gap_start ? index : index + gap]; }
+      pointer operator->() const { return &**this; }
+      reference operator[](difference_type n) const { return *(*this + n); }
+
+      basic_iterator& operator++() { ++index; return *this; }
+      basic_iterator& operator--() { --index; return *this; }
+      basic_iterator operator++(int)
+         { basic_iterator old(*this); ++index; return old; }
+      basic_iterator operator--(int)
+         { basic_iterator old(*this); --index; return old; }
+      basic_iterator& operator+=(difference_type n)
+         { index += n; return *this; }
+      basic_iterator& operator-=(difference_type n)
+         { index -= n; return *this; }
+
+      friend basic_iterator operator+(basic_iterator it, difference_type n)
+         { return it += n; }
+      friend basic_iterator operator+(difference_type n, basic_iterator it)
+         { return it += n; }
+      friend basic_iterator operator-(basic_iterator it, difference_type n)
+         { return it -= n; }
+      friend difference_type operator-(const basic_iterator& a,
+                                       const basic_iterator& b)
+         { return difference_type(a.index) - difference_type(b.index); }
+
+      friend bool operator==(const basic_iterator& a, const basic_iterator& b)
+         { return a.index == b.index; }
+      friend bool operator!=(const basic_iterator& a, const basic_iterator& b)
+         { return a.index != b.index; }
+      friend bool operator<(const basic_iterator& a, const basic_iterator& b)
+         { return a.index < b.index; }
+      friend bool operator>(const basic_iterator& a, const basic_iterator& b)
+         { return a.index > b.index; }
+      friend bool operator<=(const basic_iterator& a, const basic_iterator& b)
+         { return a.index <= b.index; }
+      friend bool operator>=(const basic_iterator& a, const basic_iterator& b)
+         { return a.index >= b.index; }
+   private:
+      template <class> friend class basic_iterator;
+      friend class sequence;
+      Item* items;          // the sequence's data array
+      size_type gap_start;  // the sequence's gap_start()
+      size_type gap;        // capacity - used
+      size_type index;      // index of the item referred to
+      basic_iterator(Item* items, size_type gap_start, size_type gap,
+                     size_type index)
+         : items(items), gap_start(gap_start), gap(gap), index(index) { }
+   };
+
+   template <class ForwardIterator>
+   void sequence::insert_range(ForwardIterator first, ForwardIterator last)
+   {
+      size_type count = std::distance(first, last);
+      if (count == 0)
+         return;
+      size_type position = is_item() ? current_index : 0;
+      size_type old_current = current_index;
+      std::copy(first, last, make_room(position, count));
+      record_inserted(position, count, old_current);
+      current_index = position + count - 1;
+   }
+
+   class sequence::cursor
+   {
+   public:
+      cursor();
+      explicit cursor(sequence& s);
+      cursor(const cursor& source);
+      ~cursor();
+      cursor& operator=(const cursor& source);
+      bool is_bound() const;
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      bool is_item() const;
+      value_type current() const;
+   private:
+      friend class sequence;
+      sequence* seq;     // the sequence bound to, or 0
+      size_type index;   // as sequence::current_index
+      cursor* prev;      // neighbors in seq's list of cursors
+      cursor* next;
+      void bind(sequence* s);
+      void unbind();
+   };
+
+   template <class Predicate>
+   sequence::size_type sequence::remove_if(Predicate pred)
+   {
+      value_type* items = make_contiguous();
+      size_type old_current = current_index;
+      // the current item and the cursors are renumbered in the same
+      // pass: a position at index i moves to the number of items kept
+      // before i (which is the next kept item if item i is removed)
+      std::vector<size_type*> positions = positions_in_order();
+      size_type next = 0;
+      size_type kept = 0;
+      for (size_type i = 0; i < used; ++i)
+      {
+         for (; next < positions.size() && *positions[next] == i; ++next)
+            *positions[next] = kept;
+         if (!pred(static_cast<const value_type&>(items[i])))
+            items[kept++] = items[i];
+         else if (recording)
+            // as if the items were removed one at a time, front to back
+            record(false, kept, items[i], old_current);
+      }
+      for (; next < positions.size(); ++next)
+         *positions[next] = kept;
+      size_type removed = used - kept;
+      used = kept;   // the gap is still at the end, so tail stays 0
+      return removed;
+   }
+
+   template <class ForwardIterator>
+   void sequence::attach_range(ForwardIterator first, ForwardIterator last)
+   {
+      size_type count = std::distance(first, last);
+      if (count == 0)
+         return;
+      size_type position = is_item() ? current_index + 1 : used;
+      size_type old_current = current_index;
+      std::copy(first, last, make_room(position, count));
+      record_inserted(position, count, old_current);
+      current_index = position + count - 1;
+   }
 }
 
 #endif
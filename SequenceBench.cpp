@@ -0,0 +1,119 @@
+// FILE: SequenceBench.cpp
+// A non-interactive benchmark of inserting into a sequence at its cursor.
+//
+// DESCRIPTION:
+// For N = 10000, 100000 and 1000000 items, two patterns are timed:
+//   front:  start, then N calls to insert (every item goes in front)
+//   middle: N/2 items attached, the cursor moved to the middle, then
+//           N/2 calls to insert, each followed by advance (every item
+//           goes right after the one inserted before it)
+// on sequence and on a plain array that shifts every item after the
+// cursor on each insert (what sequence did before the gap buffer). The
+// plain array is skipped for N = 1000000, where it takes minutes. The
+// times are printed in milliseconds.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 SequenceBench.cpp Sequence.cpp -o sqb
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include "Sequence.h"
+using namespace std;
+using namespace CS3358_FA2021;
+
+const size_t SHIFTING_LIMIT = 100000;
+
+double millisecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, milli> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// The baseline: items kept at the front of the array, cursor inserts
+// shift the rest of the items up by one.
+struct ShiftingArray
+{
+   double* data;
+   size_t used;
+   size_t current_index;
+   explicit ShiftingArray(size_t capacity)
+      : data(new double [capacity]), used(0), current_index(0) { }
+   ~ShiftingArray() { delete [] data; }
+   void start() { current_index = 0; }
+   void advance() { ++current_index; }
+   void insert(double entry)
+   {
+      copy_backward(data + current_index, data + used, data + used + 1);
+      data[current_index] = entry;
+      ++used;
+   }
+   void attach(double entry)
+   {
+      data[used] = entry;
+      current_index = used++;
+   }
+};
+
+// Runs the front pattern on target; returns the milliseconds taken.
+template <class Target>
+double frontInserts(Target& target, size_t n)
+{
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   target.start();
+   for (size_t i = 0; i < n; ++i)
+      target.insert(double(i));
+   return millisecondsSince(begin);
+}
+
+// Runs the middle pattern on target; returns the milliseconds taken
+// (the attaches that set it up are not counted).
+template <class Target>
+double middleInserts(Target& target, size_t n)
+{
+   for (size_t i = 0; i < n / 2; ++i)
+      target.attach(double(i));
+   target.start();
+   for (size_t i = 0; i < n / 4; ++i)
+      target.advance();
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   for (size_t i = 0; i < n / 2; ++i)
+   {
+      target.insert(double(i));
+      target.advance();
+   }
+   return millisecondsSince(begin);
+}
+
+int main()
+{
+   cout << fixed << setprecision(1)
+        << "    items   front: sequence  shifting  middle: sequence  shifting"
+        << "   (ms)\n";
+   for (size_t n = 10000; n <= 1000000; n *= 10)
+   {
+      sequence front, middle;
+      cout << setw(9) << n << setw(18) << frontInserts(front, n);
+      if (n <= SHIFTING_LIMIT)
+      {
+         ShiftingArray shifted(n);
+         cout << setw(10) << frontInserts(shifted, n);
+      }
+      else
+         cout << setw(10) << "-";
+      cout << setw(18) << middleInserts(middle, n);
+      if (n <= SHIFTING_LIMIT)
+      {
+         ShiftingArray shifted(n);
+         cout << setw(10) << middleInserts(shifted, n);
+      }
+      else
+         cout << setw(10) << "-";
+      // the sizes keep the work from being optimized away
+      cout << "   " << front.size() + middle.size() << "\n";
+   }
+   return 0;
+}
@@ -0,0 +1,92 @@
+// FILE: SequenceRangeBench.cpp
+// A non-interactive benchmark of insert_range and attach_range.
+//
+// DESCRIPTION:
+// For N = 10000, 100000 and 1000000 samples held in a vector, two
+// patterns are timed on a sequence of 1000 items with the cursor on
+// item [500]:
+//   attach: the samples attached one at a time, and by attach_range
+//   insert: the samples inserted one at a time (each followed by
+//           advance, so they keep their order), and by insert_range
+// The times are printed in milliseconds, along with the speedup of
+// the range functions over the loops.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 SequenceRangeBench.cpp Sequence.cpp -o srb
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "Sequence.h"
+using namespace std;
+using namespace CS3358_FA2021;
+
+const size_t START_ITEMS = 1000;
+
+double millisecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, milli> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// A sequence of START_ITEMS items with the cursor in the middle.
+sequence startingSequence()
+{
+   sequence result;
+   for (size_t i = 0; i < START_ITEMS; ++i)
+      result.attach(double(i));
+   result.start();
+   for (size_t i = 0; i < START_ITEMS / 2; ++i)
+      result.advance();
+   return result;
+}
+
+int main()
+{
+   cout << fixed << setprecision(1)
+        << "  samples   attach: loop   range  speedup"
+        << "   insert: loop   range  speedup   (ms)\n";
+   for (size_t n = 10000; n <= 1000000; n *= 10)
+   {
+      vector<double> samples(n);
+      for (size_t i = 0; i < n; ++i)
+         samples[i] = i * 0.5;
+
+      sequence looped = startingSequence();
+      chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+      for (size_t i = 0; i < n; ++i)
+         looped.attach(samples[i]);
+      double attachLoop = millisecondsSince(begin);
+
+      sequence ranged = startingSequence();
+      begin = chrono::steady_clock::now();
+      ranged.attach_range(samples.begin(), samples.end());
+      double attachRange = millisecondsSince(begin);
+
+      sequence insertLooped = startingSequence();
+      begin = chrono::steady_clock::now();
+      for (size_t i = 0; i < n; ++i)
+      {
+         insertLooped.insert(samples[i]);
+         insertLooped.advance();
+      }
+      double insertLoop = millisecondsSince(begin);
+
+      sequence insertRanged = startingSequence();
+      begin = chrono::steady_clock::now();
+      insertRanged.insert_range(samples.begin(), samples.end());
+      double insertRange = millisecondsSince(begin);
+
+      cout << setw(9) << n
+           << setw(15) << attachLoop << setw(8) << attachRange
+           << setw(8) << attachLoop / attachRange << "x"
+           << setw(15) << insertLoop << setw(8) << insertRange
+           << setw(8) << insertLoop / insertRange << "x"
+           // the sizes keep the work from being optimized away
+           << "   " << looped.size() + ranged.size() + insertLooped.size()
+                       + insertRanged.size() << "\n";
+   }
+   return 0;
+}
@@ -0,0 +1,144 @@
+// FILE: SequenceReduceBench.cpp
+// A non-interactive benchmark of the sequence numeric functions.
+//
+// DESCRIPTION:
+// A sequence of N items is built, and each of sum, sum(true), min,
+// max, variance and dot is timed against the same computation done
+// the way callers did before these functions existed: walking the
+// cursor with start/advance/current. scale is timed against writing
+// every item through an iterator. Each time is the average of REPEATS
+// runs, in microseconds, and is printed with the speedup over the
+// walk. The two results are printed too; they may differ in the last
+// few bits, since the vector code adds the items in another order.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 SequenceReduceBench.cpp Sequence.cpp -o srdb
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "Sequence.h"
+using namespace std;
+using namespace CS3358_FA2021;
+
+const size_t N = 1000000;
+const int REPEATS = 20;
+
+double microsecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, micro> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// The cursor walks (the baseline), one per function.
+double walkSum(sequence& s)
+{
+   double total = 0;
+   for (s.start(); s.is_item(); s.advance())
+      total += s.current();
+   return total;
+}
+
+double walkCompensatedSum(sequence& s)
+{
+   double total = 0, compensation = 0;
+   for (s.start(); s.is_item(); s.advance())
+   {
+      double y = s.current() - compensation;
+      double t = total + y;
+      compensation = (t - total) - y;
+      total = t;
+   }
+   return total;
+}
+
+double walkMin(sequence& s)
+{
+   s.start();
+   double result = s.current();
+   for (; s.is_item(); s.advance())
+      if (s.current() < result)
+         result = s.current();
+   return result;
+}
+
+double walkMax(sequence& s)
+{
+   s.start();
+   double result = s.current();
+   for (; s.is_item(); s.advance())
+      if (s.current() > result)
+         result = s.current();
+   return result;
+}
+
+double walkVariance(sequence& s)
+{
+   double mean = walkSum(s) / s.size();
+   double total = 0;
+   for (s.start(); s.is_item(); s.advance())
+      total += (s.current() - mean) * (s.current() - mean);
+   return total / s.size();
+}
+
+double walkDot(sequence& s, sequence& other)
+{
+   double total = 0;
+   for (s.start(), other.start(); s.is_item(); s.advance(), other.advance())
+      total += s.current() * other.current();
+   return total;
+}
+
+// Times REPEATS calls of each of walk and function, and prints a row.
+template <class Walk, class Function>
+void row(const char* name, Walk walk, Function function)
+{
+   double walked = 0, computed = 0;
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   for (int r = 0; r < REPEATS; ++r)
+      walked = walk();
+   double walkTime = microsecondsSince(begin) / REPEATS;
+   begin = chrono::steady_clock::now();
+   for (int r = 0; r < REPEATS; ++r)
+      computed = function();
+   double functionTime = microsecondsSince(begin) / REPEATS;
+   cout << setw(12) << name << setw(13) << walkTime
+        << setw(13) << functionTime
+        << setw(8) << walkTime / functionTime << "x"
+        << setw(24) << setprecision(6) << walked
+        << setw(24) << computed << setprecision(1) << "\n";
+}
+
+int main()
+{
+   sequence s, other;
+   for (size_t i = 0; i < N; ++i)
+   {
+      s.attach(double(i % 1000) * 0.001 + 1e6);
+      other.attach(double(i % 7) - 3);
+   }
+
+   cout << fixed << setprecision(1) << N << " items\n"
+        << "    function    walk (us)    call (us)  speedup"
+        << "             walk result             call result\n";
+   row("sum", [&]() { return walkSum(s); }, [&]() { return s.sum(); });
+   row("sum(true)", [&]() { return walkCompensatedSum(s); },
+       [&]() { return s.sum(true); });
+   row("min", [&]() { return walkMin(s); }, [&]() { return s.min(); });
+   row("max", [&]() { return walkMax(s); }, [&]() { return s.max(); });
+   row("variance", [&]() { return walkVariance(s); },
+       [&]() { return s.variance(); });
+   row("dot", [&]() { return walkDot(s, other); },
+       [&]() { return s.dot(other); });
+   // scale by 1 leaves the items as they are for the other rows
+   row("scale",
+       [&]()
+       {
+          for (sequence::iterator it = s.begin(); it != s.end(); ++it)
+             *it *= 1.0;
+          return s.sum();
+       },
+       [&]() { s.scale(1.0); return s.sum(); });
+   return 0;
+}
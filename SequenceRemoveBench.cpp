@@ -0,0 +1,86 @@
+// FILE: SequenceRemoveBench.cpp
+// A non-interactive benchmark of remove_if and erase_range.
+//
+// DESCRIPTION:
+// For N = 10000, 100000, 1000000 and 10000000 items, every tenth item
+// (10% of them, spread uniformly) is marked as an outlier, and two
+// ways of getting rid of them are timed:
+//   loop:      walking the cursor and calling remove_current on each
+//              outlier (what callers did before remove_if; since the
+//              gap buffer follows the cursor, this is linear too, but
+//              moves each kept item through the gap one at a time)
+//   remove_if: one call with a predicate that picks the outliers
+// and, for comparison, erase_range removing the same number of items
+// as one block from the middle. The times are printed in milliseconds.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 SequenceRemoveBench.cpp Sequence.cpp -o srmb
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "Sequence.h"
+using namespace std;
+using namespace CS3358_FA2021;
+
+const double OUTLIER = 1e9;
+
+double millisecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, milli> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// n items, every tenth of them OUTLIER.
+sequence samples(size_t n)
+{
+   sequence result(n);
+   for (size_t i = 0; i < n; ++i)
+      result.attach(i % 10 == 5 ? OUTLIER : double(i));
+   return result;
+}
+
+bool isOutlier(const double& item)
+{
+   return item == OUTLIER;
+}
+
+int main()
+{
+   cout << fixed << setprecision(2)
+        << "     items      loop  remove_if  speedup  erase_range   (ms)\n";
+   for (size_t n = 10000; n <= 10000000; n *= 10)
+   {
+      sequence looped = samples(n);
+      chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+      looped.start();
+      while (looped.is_item())
+      {
+         if (isOutlier(looped.current()))
+            looped.remove_current();
+         else
+            looped.advance();
+      }
+      double loopTime = millisecondsSince(begin);
+
+      sequence filtered = samples(n);
+      begin = chrono::steady_clock::now();
+      filtered.remove_if(isOutlier);
+      double removeIfTime = millisecondsSince(begin);
+
+      sequence erased = samples(n);
+      begin = chrono::steady_clock::now();
+      erased.erase_range(n / 2 - n / 20, n / 2 + n / 20);
+      double eraseTime = millisecondsSince(begin);
+
+      cout << setw(10) << n << setw(10) << loopTime
+           << setw(11) << removeIfTime
+           << setw(8) << loopTime / removeIfTime << "x"
+           << setw(13) << eraseTime
+           // the sizes keep the work from being optimized away
+           << "   " << looped.size() + filtered.size() + erased.size()
+           << "\n";
+   }
+   return 0;
+}
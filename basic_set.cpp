@@ -0,0 +1,456 @@
+// FILE: basic_set.cpp
+// CLASS IMPLEMENTED: basic_set and its representation policies (see
+//                    basic_set.h for documentation); this file is
+//                    included by basic_set.h since it only contains
+//                    templates.
+// INVARIANT for the basic_set class:
+//   1. The elements of the set are exactly the values stored in rep;
+//      all of basic_set's operations are written in terms of the
+//      policy interface, so every policy yields the same semantics.
+// INVARIANT for unsorted_array_policy:
+//   1. items holds the distinct elements in insertion order.
+// INVARIANT for sorted_array_policy:
+//   1. items holds the distinct elements in ascending order.
+// INVARIANT for hash_policy:
+//   1. slots.size() == states.size() and is 0 or a power of 2.
+//   2. An element is stored in the FULL slot found by probing
+//      linearly from mix(element) & (slots.size() - 1); a probe stops
+//      at the first EMPTY slot, so erase marks slots DELETED rather
+//      than EMPTY.
+//   3. used is the # of FULL slots and occupied the # of slots that
+//      are not EMPTY; occupied is kept <= slots.size() / 2 so probes
+//      stay short and always reach an EMPTY slot.
+// INVARIANT for bitmap_policy:
+//   1. Bit index(x) of words is set exactly when x is an element,
+//      where index(x) is x's distance from the smallest T value (so
+//      increasing bit index means increasing value).
+//   2. used is the # of bits set.
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <iterator>
+#include <limits>
+
+// unsorted_array_policy
+
+template <typename T>
+bool unsorted_array_policy<T>::contains(const T& item) const
+{
+   return std::find(items.begin(), items.end(), item) != items.end();
+}
+
+template <typename T>
+bool unsorted_array_policy<T>::insert(const T& item)
+{
+   if (contains(item))
+      return false;
+   items.push_back(item);
+   return true;
+}
+
+template <typename T>
+bool unsorted_array_policy<T>::erase(const T& item)
+{
+   typename std::vector<T>::iterator it =
+      std::find(items.begin(), items.end(), item);
+   if (it == items.end())
+      return false;
+   items.erase(it);
+   return true;
+}
+
+template <typename T>
+template <class Function>
+void unsorted_array_policy<T>::forEach(Function f) const
+{
+   for (std::size_t i = 0; i < items.size(); ++i)
+      f(items[i]);
+}
+
+template <typename T>
+void unsorted_array_policy<T>::assignUnion(const unsorted_array_policy& a,
+                                           const unsorted_array_policy& b)
+{
+   items = a.items;
+   for (std::size_t i = 0; i < b.items.size(); ++i)
+      if (!a.contains(b.items[i]))
+         items.push_back(b.items[i]);
+}
+
+template <typename T>
+void unsorted_array_policy<T>::assignIntersection(
+   const unsorted_array_policy& a, const unsorted_array_policy& b)
+{
+   for (std::size_t i = 0; i < a.items.size(); ++i)
+      if (b.contains(a.items[i]))
+         items.push_back(a.items[i]);
+}
+
+template <typename T>
+void unsorted_array_policy<T>::assignDifference(
+   const unsorted_array_policy& a, const unsorted_array_policy& b)
+{
+   for (std::size_t i = 0; i < a.items.size(); ++i)
+      if (!b.contains(a.items[i]))
+         items.push_back(a.items[i]);
+}
+
+// sorted_array_policy
+
+template <typename T>
+bool sorted_array_policy<T>::contains(const T& item) const
+{
+   return std::binary_search(items.begin(), items.end(), item);
+}
+
+template <typename T>
+bool sorted_array_policy<T>::insert(const T& item)
+{
+   typename std::vector<T>::iterator it =
+      std::lower_bound(items.begin(), items.end(), item);
+   if (it != items.end() && *it == item)
+      return false;
+   items.insert(it, item);
+   return true;
+}
+
+template <typename T>
+bool sorted_array_policy<T>::erase(const T& item)
+{
+   typename std::vector<T>::iterator it =
+      std::lower_bound(items.begin(), items.end(), item);
+   if (it == items.end() || *it != item)
+      return false;
+   items.erase(it);
+   return true;
+}
+
+template <typename T>
+template <class Function>
+void sorted_array_policy<T>::forEach(Function f) const
+{
+   for (std::size_t i = 0; i < items.size(); ++i)
+      f(items[i]);
+}
+
+// the set algebra merges the two ascending arrays in one pass, into
+// storage reserved up front
+
+template <typename T>
+void sorted_array_policy<T>::assignUnion(const sorted_array_policy& a,
+                                         const sorted_array_policy& b)
+{
+   items.reserve(a.items.size() + b.items.size());
+   std::set_union(a.items.begin(), a.items.end(), b.items.begin(),
+                  b.items.end(), std::back_inserter(items));
+}
+
+template <typename T>
+void sorted_array_policy<T>::assignIntersection(const sorted_array_policy& a,
+                                                const sorted_array_policy& b)
+{
+   items.reserve(std::min(a.items.size(), b.items.size()));
+   std::set_intersection(a.items.begin(), a.items.end(), b.items.begin(),
+                         b.items.end(), std::back_inserter(items));
+}
+
+template <typename T>
+void sorted_array_policy<T>::assignDifference(const sorted_array_policy& a,
+                                              const sorted_array_policy& b)
+{
+   items.reserve(a.items.size());
+   std::set_difference(a.items.begin(), a.items.end(), b.items.begin(),
+                       b.items.end(), std::back_inserter(items));
+}
+
+// hash_policy
+
+template <typename T>
+std::size_t hash_policy<T>::find(const T& item) const
+{
+   if (slots.empty())
+      return slots.size();
+   // splitmix64 finalizer, so clustered keys spread over the table
+   unsigned long long z = static_cast<unsigned long long>(item)
+                          + 0x9E3779B97F4A7C15ull;
+   z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+   z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+   std::size_t mask = slots.size() - 1;
+   std::size_t i = static_cast<std::size_t>(z ^ (z >> 31)) & mask;
+   // returns the slot holding item, or else the first EMPTY slot
+   while (states[i] != EMPTY && !(states[i] == FULL && slots[i] == item))
+      i = (i + 1) & mask;
+   return i;
+}
+
+template <typename T>
+void hash_policy<T>::rehash(std::size_t new_slot_count)
+{
+   std::vector<T> old_slots;
+   std::vector<unsigned char> old_states;
+   old_slots.swap(slots);
+   old_states.swap(states);
+   slots.assign(new_slot_count, T());
+   states.assign(new_slot_count, EMPTY);
+   occupied = used;
+   for (std::size_t i = 0; i < old_slots.size(); ++i)
+   {
+      if (old_states[i] == FULL)
+      {
+         std::size_t j = find(old_slots[i]);
+         slots[j] = old_slots[i];
+         states[j] = FULL;
+      }
+   }
+}
+
+template <typename T>
+bool hash_policy<T>::contains(const T& item) const
+{
+   std::size_t i = find(item);
+   return i < slots.size() && states[i] == FULL;
+}
+
+template <typename T>
+bool hash_policy<T>::insert(const T& item)
+{
+   if (contains(item))
+      return false;
+   if (2 * (occupied + 1) > slots.size())
+   {
+      std::size_t new_slot_count = 16;
+      while (new_slot_count < 4 * (used + 1))
+         new_slot_count *= 2;
+      rehash(new_slot_count);
+   }
+   std::size_t i = find(item);
+   slots[i] = item;
+   states[i] = FULL;
+   ++used;
+   ++occupied;
+   return true;
+}
+
+template <typename T>
+bool hash_policy<T>::erase(const T& item)
+{
+   std::size_t i = find(item);
+   if (i == slots.size() || states[i] != FULL)
+      return false;
+   states[i] = DELETED;
+   --used;
+   return true;
+}
+
+template <typename T>
+void hash_policy<T>::clear()
+{
+   slots.clear();
+   states.clear();
+   used = occupied = 0;
+}
+
+template <typename T>
+template <class Function>
+void hash_policy<T>::forEach(Function f) const
+{
+   for (std::size_t i = 0; i < slots.size(); ++i)
+      if (states[i] == FULL)
+         f(slots[i]);
+}
+
+template <typename T>
+void hash_policy<T>::assignUnion(const hash_policy& a, const hash_policy& b)
+{
+   *this = a;
+   b.forEach([&](const T& item) { insert(item); });
+}
+
+template <typename T>
+void hash_policy<T>::assignIntersection(const hash_policy& a,
+                                        const hash_policy& b)
+{
+   // probe the larger table with the elements of the smaller
+   const hash_policy& smaller = a.used <= b.used ? a : b;
+   const hash_policy& larger = a.used <= b.used ? b : a;
+   smaller.forEach([&](const T& item)
+   {
+      if (larger.contains(item))
+         insert(item);
+   });
+}
+
+template <typename T>
+void hash_policy<T>::assignDifference(const hash_policy& a,
+                                      const hash_policy& b)
+{
+   a.forEach([&](const T& item)
+   {
+      if (!b.contains(item))
+         insert(item);
+   });
+}
+
+// bitmap_policy
+
+template <typename T>
+bitmap_policy<T>::bitmap_policy()
+   : words((std::size_t(1) << BITS) / 64, 0), used(0)
+{
+   static_assert(BITS <= 16, "bitmap_policy needs a type of at most 16 bits");
+}
+
+template <typename T>
+std::size_t bitmap_policy<T>::index(const T& item)
+{
+   return static_cast<std::size_t>(static_cast<long long>(item)
+             - static_cast<long long>(std::numeric_limits<T>::min()));
+}
+
+template <typename T>
+bool bitmap_policy<T>::contains(const T& item) const
+{
+   std::size_t i = index(item);
+   return (words[i / 64] >> (i % 64)) & 1;
+}
+
+template <typename T>
+bool bitmap_policy<T>::insert(const T& item)
+{
+   if (contains(item))
+      return false;
+   std::size_t i = index(item);
+   words[i / 64] |= 1ull << (i % 64);
+   ++used;
+   return true;
+}
+
+template <typename T>
+bool bitmap_policy<T>::erase(const T& item)
+{
+   if (!contains(item))
+      return false;
+   std::size_t i = index(item);
+   words[i / 64] &= ~(1ull << (i % 64));
+   --used;
+   return true;
+}
+
+template <typename T>
+void bitmap_policy<T>::clear()
+{
+   std::fill(words.begin(), words.end(), 0);
+   used = 0;
+}
+
+template <typename T>
+template <class Function>
+void bitmap_policy<T>::forEach(Function f) const
+{
+   for (std::size_t w = 0; w < words.size(); ++w)
+   {
+      unsigned long long bits = words[w];
+      for (std::size_t b = 0; bits != 0; ++b, bits >>= 1)
+         if (bits & 1)
+            f(static_cast<T>(static_cast<long long>(w * 64 + b)
+                             + std::numeric_limits<T>::min()));
+   }
+}
+
+// the set algebra combines the bitmaps a word at a time
+
+template <typename T>
+void bitmap_policy<T>::assignUnion(const bitmap_policy& a,
+                                   const bitmap_policy& b)
+{
+   used = 0;
+   for (std::size_t w = 0; w < words.size(); ++w)
+   {
+      words[w] = a.words[w] | b.words[w];
+      used += std::bitset<64>(words[w]).count();
+   }
+}
+
+template <typename T>
+void bitmap_policy<T>::assignIntersection(const bitmap_policy& a,
+                                          const bitmap_policy& b)
+{
+   used = 0;
+   for (std::size_t w = 0; w < words.size(); ++w)
+   {
+      words[w] = a.words[w] & b.words[w];
+      used += std::bitset<64>(words[w]).count();
+   }
+}
+
+template <typename T>
+void bitmap_policy<T>::assignDifference(const bitmap_policy& a,
+                                        const bitmap_policy& b)
+{
+   used = 0;
+   for (std::size_t w = 0; w < words.size(); ++w)
+   {
+      words[w] = a.words[w] & ~b.words[w];
+      used += std::bitset<64>(words[w]).count();
+   }
+}
+
+// basic_set
+
+template <typename T, template <typename> class Policy>
+bool basic_set<T, Policy>::isSubsetOf(const basic_set& other) const
+{
+   if (size() > other.size())
+      return false;
+   bool subset = true;
+   rep.forEach([&](const T& item) { subset = subset && other.contains(item); });
+   return subset;
+}
+
+template <typename T, template <typename> class Policy>
+void basic_set<T, Policy>::DumpData(std::ostream& out) const
+{
+   bool first = true;
+   rep.forEach([&](const T& item)
+   {
+      if (!first)
+         out << "  ";
+      out << +item;   // + so char-sized types print as numbers
+      first = false;
+   });
+}
+
+template <typename T, template <typename> class Policy>
+basic_set<T, Policy>
+basic_set<T, Policy>::unionWith(const basic_set& other) const
+{
+   basic_set result;
+   result.rep.assignUnion(rep, other.rep);
+   return result;
+}
+
+template <typename T, template <typename> class Policy>
+basic_set<T, Policy>
+basic_set<T, Policy>::intersect(const basic_set& other) const
+{
+   basic_set result;
+   result.rep.assignIntersection(rep, other.rep);
+   return result;
+}
+
+template <typename T, template <typename> class Policy>
+basic_set<T, Policy>
+basic_set<T, Policy>::subtract(const basic_set& other) const
+{
+   basic_set result;
+   result.rep.assignDifference(rep, other.rep);
+   return result;
+}
+
+template <typename T, template <typename> class Policy>
+bool operator==(const basic_set<T, Policy>& s1,
+                const basic_set<T, Policy>& s2)
+{
+   return s1.size() == s2.size() && s1.isSubsetOf(s2);
+}
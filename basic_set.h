@@ -0,0 +1,241 @@
+// FILE: basic_set.h
+//////////////////////////////////////////////////////////////////////
+// NOTE: basic_set generalizes IntSet over the element type and over
+//       how the elements are stored. The representation is chosen at
+//       compile time by a policy (see REPRESENTATION POLICIES below);
+//       the set semantics and documentation are the same for all of
+//       them and follow IntSet.h.
+//       basic_set replaces the earlier copies of IntSet: the fixed-
+//       and dynamic-array versions (formerly IntSet1.h and IntSet2.h)
+//       are basic_set<int, unsorted_array_policy>, which keeps the
+//       elements in insertion order just as they did.
+//       IntSet itself (IntSet.h) is a typedef of
+//       basic_set<int, intset_policy>, an explicit specialization
+//       defined in IntSet.h: it has the interface below (with int
+//       sizes) plus IntSet's inline storage, fingerprint, Bloom
+//       filter, binary formats and parallel operations, and the
+//       layout IntSetView and ConcurrentIntSet are built on.
+//////////////////////////////////////////////////////////////////////
+// CLASS PROVIDED: basic_set<T, Policy> (a container class for a set
+//                 of T values)
+//
+// TEMPLATE PARAMETERS
+//   T       An integral type (int, long long, unsigned short, ...).
+//   Policy  One of the class templates unsorted_array_policy,
+//           sorted_array_policy (the default), hash_policy or
+//           bitmap_policy.
+//
+// TYPEDEFS
+//   typedef T value_type
+//   typedef std::size_t size_type
+//
+// CONSTRUCTOR
+//   basic_set()
+//     Post: The invoking basic_set is initialized to an empty set.
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS)
+//   size_type size() const
+//     Post: Number of elements in the invoking basic_set is returned.
+//   bool isEmpty() const
+//     Post: True is returned if the invoking basic_set has no
+//           elements, otherwise false is returned.
+//   bool contains(const value_type& item) const
+//     Post: true is returned if the invoking basic_set has item as
+//           an element, otherwise false is returned.
+//   bool isSubsetOf(const basic_set& other) const
+//     Post: True is returned if all elements of the invoking
+//           basic_set are also elements of other, otherwise false is
+//           returned (an empty basic_set is a subset of any other).
+//   void DumpData(std::ostream& out) const
+//     Post: Contents of the invoking basic_set have been inserted
+//           into out, in the order the representation keeps them,
+//           with 2 spaces separating one item from another.
+//   basic_set unionWith(const basic_set& other) const
+//   basic_set intersect(const basic_set& other) const
+//   basic_set subtract(const basic_set& other) const
+//     Post: The union, intersection or difference (elements of the
+//           invoking basic_set that are not in other) of the invoking
+//           basic_set and other is returned.
+//   template <class Function> void forEach(Function f) const
+//     Pre:  f can be called with a value_type argument.
+//     Post: f has been called once on each element (in the same
+//           order as DumpData).
+//
+// MODIFICATION MEMBER FUNCTIONS (MUTATORS)
+//   void reset()
+//     Post: The invoking basic_set is reset to become an empty set.
+//   bool add(const value_type& item)
+//     Post: If contains(item) returns false, item has been added and
+//           true is returned, otherwise the invoking basic_set is
+//           unchanged and false is returned.
+//   bool remove(const value_type& item)
+//     Post: If contains(item) returns true, item has been removed and
+//           true is returned, otherwise the invoking basic_set is
+//           unchanged and false is returned.
+//
+// NON-MEMBER FUNCTIONS
+//   bool operator==(const basic_set& s1, const basic_set& s2)
+//     Post: True is returned if s1 and s2 have the same elements,
+//           otherwise false is returned.
+//
+// REPRESENTATION POLICIES
+//   Each policy is a class template over T that stores distinct T
+//   values and provides size(), contains(item), insert(item) (returns
+//   false if already present), erase(item) (returns false if absent),
+//   clear() and forEach(f), plus assignUnion(a, b),
+//   assignIntersection(a, b) and assignDifference(a, b), which make
+//   the (empty) invoking policy the union, intersection or difference
+//   of a and b in the policy's own way. Costs for n elements (m in
+//   the other operand of the set algebra):
+//     unsorted_array_policy  contiguous, insertion order;
+//                            contains/insert/erase O(n);
+//                            set algebra O(n * m)
+//     sorted_array_policy    contiguous, ascending order;
+//                            contains O(log n), insert/erase O(n);
+//                            set algebra O(n + m) (a merge)
+//     hash_policy            open addressing, arbitrary order;
+//                            contains/insert/erase O(1) expected;
+//                            set algebra O(n + m) expected
+//     bitmap_policy          one bit per possible value, ascending
+//                            order; contains/insert/erase O(1); set
+//                            algebra one pass over the bitmaps; only
+//                            for types of at most 16 bits (e.g.
+//                            uint16_t codes), 8 KB per set
+//     intset_policy          only for int: selects the basic_set<int>
+//                            specialization in IntSet.h (include it
+//                            instead of this file); sorted like
+//                            sorted_array_policy
+//
+// VALUE SEMANTICS
+//   Assignment and the copy constructor may be used with basic_set
+//   objects.
+
+#ifndef BASIC_SET_H
+#define BASIC_SET_H
+
+#include <cstdlib>   // provides size_t
+#include <iostream>
+#include <vector>
+
+template <typename T>
+class unsorted_array_policy
+{
+public:
+   std::size_t size() const { return items.size(); }
+   bool contains(const T& item) const;
+   bool insert(const T& item);
+   bool erase(const T& item);
+   void clear() { items.clear(); }
+   template <class Function>
+   void forEach(Function f) const;
+   void assignUnion(const unsorted_array_policy& a,
+                    const unsorted_array_policy& b);
+   void assignIntersection(const unsorted_array_policy& a,
+                           const unsorted_array_policy& b);
+   void assignDifference(const unsorted_array_policy& a,
+                         const unsorted_array_policy& b);
+private:
+   std::vector<T> items;
+};
+
+template <typename T>
+class sorted_array_policy
+{
+public:
+   std::size_t size() const { return items.size(); }
+   bool contains(const T& item) const;
+   bool insert(const T& item);
+   bool erase(const T& item);
+   void clear() { items.clear(); }
+   template <class Function>
+   void forEach(Function f) const;
+   void assignUnion(const sorted_array_policy& a,
+                    const sorted_array_policy& b);
+   void assignIntersection(const sorted_array_policy& a,
+                           const sorted_array_policy& b);
+   void assignDifference(const sorted_array_policy& a,
+                         const sorted_array_policy& b);
+private:
+   std::vector<T> items;
+};
+
+template <typename T>
+class hash_policy
+{
+public:
+   hash_policy() : used(0), occupied(0) { }
+   std::size_t size() const { return used; }
+   bool contains(const T& item) const;
+   bool insert(const T& item);
+   bool erase(const T& item);
+   void clear();
+   template <class Function>
+   void forEach(Function f) const;
+   void assignUnion(const hash_policy& a, const hash_policy& b);
+   void assignIntersection(const hash_policy& a, const hash_policy& b);
+   void assignDifference(const hash_policy& a, const hash_policy& b);
+private:
+   enum slot_state { EMPTY, FULL, DELETED };
+   std::vector<T> slots;
+   std::vector<unsigned char> states;
+   std::size_t used;       // # of FULL slots
+   std::size_t occupied;   // # of FULL plus DELETED slots
+   std::size_t find(const T& item) const;
+   void rehash(std::size_t new_slot_count);
+};
+
+template <typename T>
+class bitmap_policy
+{
+public:
+   bitmap_policy();
+   std::size_t size() const { return used; }
+   bool contains(const T& item) const;
+   bool insert(const T& item);
+   bool erase(const T& item);
+   void clear();
+   template <class Function>
+   void forEach(Function f) const;
+   void assignUnion(const bitmap_policy& a, const bitmap_policy& b);
+   void assignIntersection(const bitmap_policy& a, const bitmap_policy& b);
+   void assignDifference(const bitmap_policy& a, const bitmap_policy& b);
+private:
+   static const std::size_t BITS = 8 * sizeof(T);
+   std::vector<unsigned long long> words;
+   std::size_t used;
+   static std::size_t index(const T& item);
+};
+
+// (only a tag: basic_set<int, intset_policy> is specialized in IntSet.h)
+template <typename T>
+class intset_policy;
+
+template <typename T, template <typename> class Policy = sorted_array_policy>
+class basic_set
+{
+public:
+   typedef T value_type;
+   typedef std::size_t size_type;
+   size_type size() const { return rep.size(); }
+   bool isEmpty() const { return rep.size() == 0; }
+   bool contains(const value_type& item) const { return rep.contains(item); }
+   bool isSubsetOf(const basic_set& other) const;
+   void DumpData(std::ostream& out) const;
+   basic_set unionWith(const basic_set& other) const;
+   basic_set intersect(const basic_set& other) const;
+   basic_set subtract(const basic_set& other) const;
+   template <class Function>
+   void forEach(Function f) const { rep.forEach(f); }
+   void reset() { rep.clear(); }
+   bool add(const value_type& item) { return rep.insert(item); }
+   bool remove(const value_type& item) { return rep.erase(item); }
+private:
+   Policy<T> rep;
+};
+
+template <typename T, template <typename> class Policy>
+bool operator==(const basic_set<T, Policy>& s1,
+                const basic_set<T, Policy>& s2);
+
+#include "basic_set.cpp"
+#endif
@@ -0,0 +1,114 @@
+// FILE: basic_setBench.cpp
+// A non-interactive benchmark of basic_set across element types and
+// representation policies.
+//
+// DESCRIPTION:
+// For each element type (int, int64_t, uint16_t) and each policy that
+// supports it, two sets of N random elements are built with add, then
+// timed: the adds, LOOKUPS contains calls (half of them hits), and
+// unionWith, intersect and subtract of the two sets. The times are
+// printed in microseconds as one row of a matrix per type/policy pair.
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 basic_setBench.cpp -o bsb
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "basic_set.h"
+using namespace std;
+
+const int N = 4000;
+const int LOOKUPS = 200000;
+
+double microsecondsSince(chrono::steady_clock::time_point begin)
+{
+   chrono::duration<double, micro> elapsed =
+      chrono::steady_clock::now() - begin;
+   return elapsed.count();
+}
+
+// Random values in [0, range), the same sequence for every row.
+template <typename T>
+vector<T> randomValues(int count, unsigned long long range, unsigned seed)
+{
+   vector<T> values(count);
+   unsigned long long state = seed;
+   for (int i = 0; i < count; ++i)
+   {
+      state = state * 6364136223846793005ull + 1442695040888963407ull;
+      values[i] = T((state >> 24) % range);
+   }
+   return values;
+}
+
+template <typename T, template <typename> class Policy>
+void benchmarkRow(const char* typeName, const char* policyName,
+                  unsigned long long range)
+{
+   vector<T> aValues = randomValues<T>(N, range, 1);
+   vector<T> bValues = randomValues<T>(N, range, 2);
+   vector<T> probes = randomValues<T>(LOOKUPS, 2 * range, 3);
+   basic_set<T, Policy> a, b;
+
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   for (int i = 0; i < N; ++i)
+      a.add(aValues[i]);
+   double addTime = microsecondsSince(begin);
+   for (int i = 0; i < N; ++i)
+      b.add(bValues[i]);
+
+   begin = chrono::steady_clock::now();
+   int hits = 0;
+   for (int i = 0; i < LOOKUPS; ++i)
+      hits += a.contains(probes[i]);
+   double containsTime = microsecondsSince(begin);
+
+   begin = chrono::steady_clock::now();
+   size_t unionSize = a.unionWith(b).size();
+   double unionTime = microsecondsSince(begin);
+   begin = chrono::steady_clock::now();
+   size_t intersectSize = a.intersect(b).size();
+   double intersectTime = microsecondsSince(begin);
+   begin = chrono::steady_clock::now();
+   size_t subtractSize = a.subtract(b).size();
+   double subtractTime = microsecondsSince(begin);
+
+   // the sizes don't depend on the policy; printing them keeps the
+   // work from being optimized away and shows the rows agree
+   cout << setw(9) << typeName << setw(9) << policyName
+        << setw(10) << addTime << setw(10) << containsTime
+        << setw(10) << unionTime << setw(10) << intersectTime
+        << setw(10) << subtractTime << "   " << hits << " "
+        << unionSize << " " << intersectSize << " " << subtractSize
+        << "\n";
+}
+
+int main()
+{
+   cout << fixed << setprecision(0)
+        << N << " elements per set, " << LOOKUPS
+        << " lookups; times in microseconds\n"
+        << "     type   policy       add  contains     union"
+        << " intersect  subtract   (hits, result sizes)\n";
+   // values drawn from 4 * N possible, so the sets overlap partly
+   const unsigned long long RANGE = 4 * N;
+
+   benchmarkRow<int, unsorted_array_policy>("int", "unsorted", RANGE);
+   benchmarkRow<int, sorted_array_policy>("int", "sorted", RANGE);
+   benchmarkRow<int, hash_policy>("int", "hash", RANGE);
+
+   benchmarkRow<int64_t, unsorted_array_policy>("int64_t", "unsorted",
+                                                RANGE);
+   benchmarkRow<int64_t, sorted_array_policy>("int64_t", "sorted", RANGE);
+   benchmarkRow<int64_t, hash_policy>("int64_t", "hash", RANGE);
+
+   benchmarkRow<uint16_t, unsorted_array_policy>("uint16_t", "unsorted",
+                                                 RANGE);
+   benchmarkRow<uint16_t, sorted_array_policy>("uint16_t", "sorted", RANGE);
+   benchmarkRow<uint16_t, hash_policy>("uint16_t", "hash", RANGE);
+   benchmarkRow<uint16_t, bitmap_policy>("uint16_t", "bitmap", RANGE);
+   return 0;
+}
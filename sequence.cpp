@@ -5,9 +5,12 @@
 //   1. The number of items in the sequence is in the member variable
 //      used;
 //   2. The actual items of the sequence are stored in a partially
-//      filled array. The array is a compile-time array whose size
-//      is fixed at CAPACITY; the  member variable data references
-//      the array.
+//      filled array of slots items, which the member variable data
+//      points to. While the items fit in N slots, the array is the
+//      compile-time array inline_data inside the object (data ==
+//      inline_data, slots == N); otherwise it is a dynamic array
+//      of slots > N items owned by the sequence. inline_data is
+//      unused while data points to a dynamic array.
 //   3. For an empty sequence, we do not care what is stored in any
 //      of data; for a non-empty sequence the items in the sequence
 //      are stored in data[0] through data[used-1], and we don't care
@@ -38,32 +41,70 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//
+// DOCUMENTATION for private member (helper) functions:
+//   bool is_inline() const
+//     Pre:  (none)
+//     Post: True is returned if the items are in inline_data, false if
+//           they are in a dynamic array.
+//   void reallocate(size_type new_slots)
+//     Pre:  new_slots >= used and new_slots > N.
+//     Post: The items have been moved to a new dynamic array of
+//           new_slots items (the old dynamic array, if any, has been
+//           released). If allocating throws, nothing has changed.
+//   void release()
+//     Pre:  (none)
+//     Post: The dynamic array (if any) has been released and data
+//           points to inline_data again; the items in it are lost,
+//           so the caller must set used.
 
 #include <cassert>
+#include <utility>  // provides move
 #include "sequence.h"
 
 namespace CS3358_FA2021_A04
 {
 
-    template <typename T>
-    sequence<T>::sequence() : used(0), current_index(0) { }
+    template <typename T, size_t N>
+    sequence<T, N>::sequence()
+        : data(inline_data), used(0), current_index(0), slots(N)
+    {
+        static_assert(N >= 1, "sequence needs an inline capacity of at least 1");
+    }
+
+    template <typename T, size_t N>
+    sequence<T, N>::sequence(const sequence& source)
+        : data(inline_data), used(0), current_index(0), slots(N)
+    {
+        *this = source;
+    }
+
+    template <typename T, size_t N>
+    sequence<T, N>::sequence(sequence&& source)
+        : data(inline_data), used(0), current_index(0), slots(N)
+    {
+        *this = std::move(source);
+    }
+
+    template <typename T, size_t N>
+    sequence<T, N>::~sequence() { release(); }
 
-    template <typename T>
-    void sequence<T>::start() { current_index = 0; }
+    template <typename T, size_t N>
+    void sequence<T, N>::start() { current_index = 0; }
 
-    template <typename T>
-    void sequence<T>::end()
+    template <typename T, size_t N>
+    void sequence<T, N>::end()
     { current_index = (used > 0) ? used - 1 : 0; }
 
-    template <typename T>
-    void sequence<T>::advance()
+    template <typename T, size_t N>
+    void sequence<T, N>::advance()
     {
         assert( is_item() );
         ++current_index;
     }
 
-    template <typename T>
-    void sequence<T>::move_back()
+    template <typename T, size_t N>
+    void sequence<T, N>::move_back()
     {
         assert( is_item() );
         if (current_index == 0)
@@ -72,33 +113,24 @@ namespace CS3358_FA2021_A04
             --current_index;
     }
 
-    template <typename T>
-    void sequence<T>::add(const value_type& entry)
+    template <typename T, size_t N>
+    void sequence<T, N>::add(const value_type& entry)
     {
-        assert( size() < CAPACITY );
+        if (used == slots)
+            reallocate(2 * slots);
 
-        size_type i;
+        // new item goes after the current item, or first if none
+        size_type position = is_item() ? current_index + 1 : 0;
 
-        if ( ! is_item() )
-        {
-            if (used > 0)
-                for (i = used; i >= 1; --i)
-                    data[i] = data[i - 1];
-            data[0] = entry;
-            current_index = 0;
-        }
-        else
-        {
-            ++current_index;
-            for (i = used; i > current_index; --i)
-                data[i] = data[i - 1];
-            data[current_index] = entry;
-        }
+        for (size_type i = used; i > position; --i)
+            data[i] = data[i - 1];
+        data[position] = entry;
+        current_index = position;
         ++used;
     }
 
-    template <typename T>
-    void sequence<T>::remove_current()
+    template <typename T, size_t N>
+    void sequence<T, N>::remove_current()
     {
         assert( is_item() );
 
@@ -109,17 +141,94 @@ namespace CS3358_FA2021_A04
         --used;
     }
 
-    template <typename T>
-    typename sequence<T>::size_type sequence<T>::size() const { return used; }
+    template <typename T, size_t N>
+    sequence<T, N>& sequence<T, N>::operator=(const sequence& source)
+    {
+        if (this != &source)
+        {
+            if (source.used > slots)
+            {
+                // allocate before releasing, so a failure changes nothing
+                value_type* new_data = new value_type[source.used];
+                release();
+                data = new_data;
+                slots = source.used;
+            }
+            for (size_type i = 0; i < source.used; ++i)
+                data[i] = source.data[i];
+            used = source.used;
+            current_index = source.current_index;
+        }
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    sequence<T, N>& sequence<T, N>::operator=(sequence&& source)
+    {
+        if (this != &source)
+        {
+            if (source.is_inline())
+            {
+                // at most N items, which always fit in data
+                for (size_type i = 0; i < source.used; ++i)
+                    data[i] = std::move(source.data[i]);
+            }
+            else
+            {
+                release();
+                data = source.data;
+                slots = source.slots;
+                source.data = source.inline_data;
+                source.slots = N;
+            }
+            used = source.used;
+            current_index = source.current_index;
+            source.used = source.current_index = 0;
+        }
+        return *this;
+    }
+
+    template <typename T, size_t N>
+    typename sequence<T, N>::size_type sequence<T, N>::size() const { return used; }
 
-    template <typename T>
-    bool sequence< T >::is_item() const { return (current_index < used); }
+    template <typename T, size_t N>
+    bool sequence<T, N>::is_item() const { return (current_index < used); }
 
-    template <typename T>
-    typename sequence<T>::value_type sequence<T>::current() const
+    template <typename T, size_t N>
+    typename sequence<T, N>::value_type sequence<T, N>::current() const
     {
         assert( is_item() );
 
         return data[current_index];
     }
+
+    template <typename T, size_t N>
+    typename sequence<T, N>::size_type sequence<T, N>::capacity() const
+    { return slots; }
+
+    template <typename T, size_t N>
+    bool sequence<T, N>::is_inline() const { return data == inline_data; }
+
+    template <typename T, size_t N>
+    void sequence<T, N>::reallocate(size_type new_slots)
+    {
+        assert( new_slots >= used && new_slots > N );
+
+        value_type* new_data = new value_type[new_slots];
+        for (size_type i = 0; i < used; ++i)
+            new_data[i] = std::move(data[i]);
+        if (!is_inline())
+            delete [] data;
+        data = new_data;
+        slots = new_slots;
+    }
+
+    template <typename T, size_t N>
+    void sequence<T, N>::release()
+    {
+        if (!is_inline())
+            delete [] data;
+        data = inline_data;
+        slots = N;
+    }
 }
@@ -9,6 +9,13 @@
 //                 where each list may have a designated item called
 //                 the current item)
 //
+// TEMPLATE PARAMETERS for the sequence class:
+//   template <typename T, size_t N = 10> class sequence
+//     T is the type of the items. N (at least 1) is how many items a
+//     sequence holds inside the object itself, without allocating
+//     dynamic memory; a sequence that grows beyond that moves its
+//     items to a dynamic array, like a "small vector".
+//
 // TYPEDEFS and MEMBER functions for the sequence class:
 //   typedef ____ value_type
 //     sequence::value_type is the data type of the items in the sequence.
@@ -18,14 +25,26 @@
 //   typedef ____ size_type
 //     sequence::size_type is the data type of any variable that keeps
 //     track of how many items are in a sequence.
-//   static const size_type CAPACITY = _____
-//     sequence::CAPACITY is the maximum number of items that a
-//     sequence can hold.
+//   static const size_type INLINE_CAPACITY = N
+//     sequence::INLINE_CAPACITY is the number of items that a
+//     sequence can hold without allocating dynamic memory.
 //
-// CONSTRUCTOR for the sequence class:
+// CONSTRUCTOR and DESTRUCTOR for the sequence class:
 //   sequence()
 //     Pre:  (none)
-//     Post: The sequence has been initialized as an empty sequence.
+//     Post: The sequence has been initialized as an empty sequence,
+//           with room for INLINE_CAPACITY items (no dynamic memory
+//           is allocated).
+//   sequence(const sequence& source)
+//   sequence(sequence&& source)
+//     Pre:  (none)
+//     Post: The sequence has been initialized with the same items and
+//           current item as source. Moving a sequence whose items are
+//           in dynamic memory takes that memory over instead of
+//           copying the items. A moved-from source is left empty.
+//   ~sequence()
+//     Pre:  (none)
+//     Post: Any dynamic memory used by the sequence has been released.
 //
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void start()
@@ -47,12 +66,16 @@
 //           there is no longer any current item. Otherwise, the new current
 //           item is the item immediately before the original current item.
 //   void add(const value_type& entry)
-//     Pre:  size() < CAPACITY.
+//     Pre:  (none)
 //     Post: A new copy of entry has been inserted in the sequence after
 //           the current item. If there was no current item, then the new
 //           entry has been inserted as new first item of the sequence. In
 //           either case, the newly added item is now the current item of
 //           the sequence.
+//     Note: If the sequence is full, its items are first moved to a
+//           dynamic array of twice the size (so a sequence of n items
+//           is grown O(log n) times in all), which may throw
+//           bad_alloc; the sequence is then unchanged.
 //   void remove_current()
 //     Pre:  is_item() returns true.
 //     Post: The current item has been removed from the sequence, and
@@ -73,9 +96,15 @@
 //   value_type current() const
 //     Pre:  is_item() returns true.
 //     Post: The item returned is the current item in the sequence.
+//   size_type capacity() const
+//     Pre:  (none)
+//     Post: The return value is the number of items the sequence can
+//           hold before add next grows it (INLINE_CAPACITY while no
+//           dynamic memory is in use).
 // VALUE SEMANTICS for the sequence class:
 //    Assignments and the copy constructor may be used with sequence
-//    objects.
+//    objects. A copy of a sequence that fits in INLINE_CAPACITY items
+//    allocates no dynamic memory.
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
@@ -84,16 +113,19 @@
 
 namespace CS3358_FA2021_A04
 {
-    template <typename T>
+    template <typename T, size_t N = 10>
     class sequence
     {
     public:
         // TYPEDEFS and MEMBER CONSTANTS
         typedef T value_type;
         typedef size_t size_type;
-        static const size_type CAPACITY = 10;
-        // CONSTRUCTOR
+        static const size_type INLINE_CAPACITY = N;
+        // CONSTRUCTORS and DESTRUCTOR
         sequence();
+        sequence(const sequence& source);
+        sequence(sequence&& source);
+        ~sequence();
         // MODIFICATION MEMBER FUNCTIONS
         void start();
         void end();
@@ -101,15 +133,23 @@ namespace CS3358_FA2021_A04
         void move_back();
         void add(const value_type& entry);
         void remove_current();
+        sequence& operator=(const sequence& source);
+        sequence& operator=(sequence&& source);
         // CONSTANT MEMBER FUNCTIONS
         size_type size() const;
         bool is_item() const;
         value_type current() const;
+        size_type capacity() const;
 
     private:
-        value_type data[CAPACITY];
+        value_type inline_data[N];
+        value_type* data;
         size_type used;
         size_type current_index;
+        size_type slots;
+        bool is_inline() const;
+        void reallocate(size_type new_slots);
+        void release();
     };
 
 }
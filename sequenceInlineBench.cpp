@@ -0,0 +1,107 @@
+// FILE: sequenceInlineBench.cpp
+// A non-interactive benchmark of the template sequence<T, N> against
+// std::vector.
+//
+// DESCRIPTION:
+// For sizes n from 1 to 1000, a container of doubles is built by
+// adding n items at the end and then destroyed, over and over, as:
+//   std::vector<double> with push_back
+//   std::vector<double> with reserve(n) first, then push_back
+//   sequence<double> (INLINE_CAPACITY 10) with add
+//   sequence<double, 32> with add
+// The average time per container is printed in nanoseconds, along
+// with the # of dynamic allocations each one made (counted by the
+// replacement operator new below).
+//
+// BUILD (one line):
+//   g++ -O2 -std=c++11 sequenceInlineBench.cpp -o sib
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+#include "sequence.h"
+using namespace std;
+using CS3358_FA2021_A04::sequence;
+
+size_t allocations = 0;
+
+void* operator new(size_t bytes)
+{
+   ++allocations;
+   void* memory = malloc(bytes > 0 ? bytes : 1);
+   if (memory == 0)
+      throw bad_alloc();
+   return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+   free(memory);
+}
+
+volatile double sink;   // keeps the work from being optimized away
+
+// Builds (with fill) and destroys a container of n items repeats
+// times; prints the average nanoseconds and allocations per container.
+template <class Fill>
+void column(Fill fill, int n, int repeats)
+{
+   size_t before = allocations;
+   chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+   for (int r = 0; r < repeats; ++r)
+      fill(n);
+   chrono::duration<double, nano> elapsed =
+      chrono::steady_clock::now() - begin;
+   cout << setw(10) << elapsed.count() / repeats << " ns"
+        << setw(4) << (allocations - before) / repeats;
+}
+
+int main()
+{
+   const int SIZES[] = { 1, 2, 5, 10, 16, 32, 100, 1000 };
+   const char* NAMES[] = { "vector", "+reserve", "seq<N=10>", "seq<N=32>" };
+   cout << fixed << setprecision(1) << setw(6) << "n";
+   for (int c = 0; c < 4; ++c)
+      cout << setw(13) << NAMES[c] << " new";
+   cout << "\n";
+   for (size_t s = 0; s < sizeof SIZES / sizeof SIZES[0]; ++s)
+   {
+      int n = SIZES[s];
+      int repeats = 20000000 / (n + 10);
+      cout << setw(6) << n;
+      column([](int count)
+             {
+                vector<double> items;
+                for (int i = 0; i < count; ++i)
+                   items.push_back(i);
+                sink = items.back();
+             }, n, repeats);
+      column([](int count)
+             {
+                vector<double> items;
+                items.reserve(count);
+                for (int i = 0; i < count; ++i)
+                   items.push_back(i);
+                sink = items.back();
+             }, n, repeats);
+      column([](int count)
+             {
+                sequence<double> items;
+                for (int i = 0; i < count; ++i)
+                   items.add(i);
+                sink = items.current();
+             }, n, repeats);
+      column([](int count)
+             {
+                sequence<double, 32> items;
+                for (int i = 0; i < count; ++i)
+                   items.add(i);
+                sink = items.current();
+             }, n, repeats);
+      cout << "\n";
+   }
+   return 0;
+}